@@ -0,0 +1,131 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Simulated state of every device the robot code can talk to. The fake PROS
+ * classes read and write these, and plants (see addPlant) couple them
+ * together to model the physical robot.
+ *
+ * None of these are locked: the sim kernel only ever lets one task run at a
+ * time, and plants are stepped while every task is parked.
+ */
+namespace sim {
+
+struct Motor {
+    enum class Mode { VOLTAGE, VELOCITY, POSITION };
+    Mode mode = Mode::VOLTAGE;
+    /** commanded voltage in mV, already accounting for reversal */
+    int32_t voltage = 0;
+    /** target of the built in velocity/position controller, in rpm */
+    double targetVelocity = 0;
+    /** target of the built in position controller, in degrees */
+    double targetPosition = 0;
+    /** voltage in mV applied by the environment (gravity, friction) */
+    int32_t externalVoltage = 0;
+    /** 0 = coast, 1 = brake, 2 = hold */
+    int32_t brakeMode = 0;
+    /** true while brake() is holding the motor */
+    bool braking = false;
+    /** 0 = red, 1 = green, 2 = blue */
+    int32_t gearing = 1;
+    /** 0 = degrees, 1 = rotations, 2 = counts */
+    int32_t encoderUnits = 0;
+    int32_t currentLimit = 2500;
+    int32_t voltageLimit = 0;
+    /** free speed of the cartridge in rpm */
+    double freeSpeed = 200;
+    /** time constant of the first order velocity response, in seconds */
+    double timeConstant = 0.08;
+    /** output shaft velocity in rpm */
+    double velocity = 0;
+    /** output shaft position in degrees */
+    double position = 0;
+    double temperature = 25;
+};
+
+struct Rotation {
+    /** position in centidegrees, not wrapped */
+    double position = 0;
+    /** velocity in centidegrees per second */
+    double velocity = 0;
+    bool reversed = false;
+    uint32_t dataRate = 10;
+};
+
+struct Imu {
+    /** unbounded clockwise rotation of the robot in degrees */
+    double rotation = 0;
+    /** added to rotation to get the reported heading */
+    double headingOffset = 0;
+    /** added to rotation to get the reported rotation */
+    double rotationOffset = 0;
+    /** clockwise yaw rate in degrees per second */
+    double gyroZ = 0;
+    uint32_t dataRate = 10;
+    /** virtual ms at which calibration finishes */
+    uint32_t calibratedAt = 0;
+};
+
+struct Optical {
+    double hue = 0;
+    double saturation = 0;
+    double brightness = 0;
+    int32_t proximity = 0;
+    double red = 0;
+    double green = 0;
+    double blue = 0;
+    uint8_t ledPwm = 0;
+    double integrationTime = 100;
+};
+
+/** @brief a three wire port on the brain or on an expander */
+struct AdiPort {
+    int32_t value = 0;
+    int32_t config = 0;
+};
+
+struct Led {
+    std::vector<uint32_t> pixels;
+    /** how many times the strip has been pushed over the wire */
+    uint32_t flushes = 0;
+};
+
+struct Controller {
+    /** left x, left y, right x, right y */
+    std::array<int32_t, 4> analog {};
+    /** indexed by controller_digital_e_t - E_CONTROLLER_DIGITAL_L1 */
+    std::array<bool, 12> digital {};
+};
+
+struct Lcd {
+    std::array<std::string, 8> lines;
+    /** how many times a line has been re-rendered */
+    uint32_t prints = 0;
+};
+
+/** @param port smart port, 1-21 */
+Motor& motor(uint8_t port);
+Rotation& rotation(uint8_t port);
+Imu& imu(uint8_t port);
+Optical& optical(uint8_t port);
+
+/**
+ * @param smartPort 22 for the brain's ports, otherwise the expander's port
+ * @param adiPort 1-8
+ */
+AdiPort& adi(uint8_t smartPort, uint8_t adiPort);
+Led& led(uint8_t smartPort, uint8_t adiPort);
+
+Controller& controller();
+Lcd& lcd();
+
+/**
+ * @brief Adds a function that models part of the robot. Plants are stepped
+ * after the motors, in the order they were added.
+ */
+void addPlant(std::function<void(double dt)> plant);
+} // namespace sim
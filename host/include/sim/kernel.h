@@ -0,0 +1,136 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sim {
+
+/**
+ * @brief A virtual time, single core scheduler that stands in for the V5's
+ * FreeRTOS kernel. Follows the singleton pattern.
+ *
+ * Every pros::Task is backed by a host thread, but only the task that holds
+ * the "cpu" is ever allowed to run, just like the brain's single Cortex-A9.
+ * The cpu changes hands only when the running task blocks (delay, mutex,
+ * notify, join) or exits. When nothing is ready, the virtual clock jumps
+ * straight to the next wake up, so the robot code runs as fast as the host
+ * can execute it.
+ *
+ * The wall clock time a task spends running is charged to the virtual clock,
+ * multiplied by the cpu scale, so that loop costs and overruns still show up
+ * in pros::micros().
+ */
+class Kernel {
+  public:
+    enum class State { READY, RUNNING, BLOCKED, SUSPENDED, DELETED };
+
+    struct Task {
+        std::string name;
+        uint32_t priority;
+        State state = State::READY;
+        /** virtual time at which a blocked task times out */
+        uint64_t wakeTime = 0;
+        /** what the task is blocked on, nullptr if only sleeping */
+        const void* waitingOn = nullptr;
+        /** set if the task left BLOCKED because its wakeTime passed */
+        bool timedOut = false;
+        uint32_t notifyValue = 0;
+        /** virtual microseconds this task has spent holding the cpu */
+        uint64_t cpuTime = 0;
+        std::function<void()> function;
+    };
+
+    struct Mutex {
+        Task* owner = nullptr;
+        std::deque<Task*> waiters;
+    };
+
+    static constexpr uint64_t NEVER = UINT64_MAX;
+
+    static Kernel& get();
+
+    /** @brief Creates a task, which will first run once the creator blocks. */
+    Task* create(std::function<void()> function, uint32_t priority,
+                 const char* name);
+    /** @return the task currently holding the cpu */
+    Task* current();
+
+    /** @return virtual time in microseconds, including the running slice */
+    uint64_t micros();
+
+    /** @brief Blocks the current task until the virtual time reaches wake. */
+    void sleepUntil(uint64_t wake);
+    /** @brief Lets other ready tasks of the same priority run. */
+    void yield();
+
+    bool take(Mutex* mutex, uint32_t timeoutMs);
+    bool give(Mutex* mutex);
+
+    uint32_t notify(Task* task, uint32_t value, int action,
+                    uint32_t* prevValue);
+    uint32_t notifyTake(bool clearOnExit, uint32_t timeoutMs);
+    void join(Task* task);
+    void suspend(Task* task);
+    void resume(Task* task);
+    /** @brief Deletes task. Deleting the current task never returns. */
+    void remove(Task* task);
+
+    void setPriority(Task* task, uint32_t priority);
+    Task* find(const char* name);
+    uint32_t count();
+    /** @return a copy of every task that has ever been created */
+    std::vector<Task> tasks();
+
+    /**
+     * @brief Sets how many virtual microseconds each microsecond of host cpu
+     * time is worth. 0 makes robot code free, which is fully deterministic.
+     */
+    void setCpuScale(double scale);
+
+    /**
+     * @brief Adds a function that is called with the elapsed virtual seconds
+     * whenever the clock advances. Used to step the simulated physics.
+     */
+    void addStepper(std::function<void(double dt)> stepper);
+
+    /** @brief Flushes stdout and terminates without unwinding the tasks. */
+    [[noreturn]] void exit(int code);
+  private:
+    Kernel();
+
+    /** @brief Hands the cpu to the next ready task. Requires m_mutex. */
+    void dispatch();
+    /** @brief Parks the calling thread until task holds the cpu. */
+    void waitForCpu(std::unique_lock<std::mutex>& lock, Task* task);
+    /** @brief Blocks the running task until it's woken up. Requires m_mutex. */
+    void block(std::unique_lock<std::mutex>& lock, uint64_t wakeTime,
+               const void* waitingOn);
+    /** @brief Moves a blocked task onto the ready queue. Requires m_mutex. */
+    void unblock(Task* task);
+    /** @brief Charges the running slice to the clock. Requires m_mutex. */
+    void chargeSlice();
+    /** @brief Steps the physics up to m_now. Requires m_mutex. */
+    void step();
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+
+    std::list<Task> m_tasks;
+    std::deque<Task*> m_ready;
+    Task* m_running;
+
+    uint64_t m_now = 0;
+    uint64_t m_lastStep = 0;
+    double m_cpuScale = 1.0;
+    std::chrono::steady_clock::time_point m_sliceStart;
+
+    std::vector<std::function<void(double dt)>> m_steppers;
+};
+} // namespace sim
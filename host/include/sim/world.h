@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+
+/**
+ * Plants that model the physical robot, wired to the same ports as
+ * src/config. If a port changes there, it has to change here too.
+ */
+namespace sim::world {
+
+struct Pose {
+    /** inches */
+    double x = 0;
+    /** inches */
+    double y = 0;
+    /** clockwise radians, 0 facing +y */
+    double theta = 0;
+};
+
+struct Ring {
+    /** distance along the intake from where rings are picked up, in inches */
+    double position = 0;
+    /** hue reported by the optical sensor */
+    double hue = 0;
+    /** when the ring was fed into the intake, in seconds */
+    double fedAt = 0;
+};
+
+/** @brief What happened to the rings that left the intake, other than onto
+ * the lift. */
+struct Sorting {
+    uint32_t redScored = 0;
+    uint32_t blueScored = 0;
+    /** thrown off the top by the intake stopping suddenly */
+    uint32_t redEjected = 0;
+    uint32_t blueEjected = 0;
+    /** pushed back out the front of the intake */
+    uint32_t lost = 0;
+};
+
+/** @brief Adds every plant to the simulation. */
+void init();
+
+/** @return the true pose of the simulated robot */
+const Pose& pose();
+
+/** @return the true angle of the lift, in degrees */
+double liftAngle();
+
+/**
+ * @brief Places a ring at the mouth of the intake. It moves with the intake
+ * chain and is seen by the optical sensor on the way through.
+ */
+void feedRing(double hue);
+
+/** @return the rings currently inside the intake */
+const std::deque<Ring>& rings();
+
+/** @return how many rings the lift is holding */
+uint32_t ringsOnLift();
+
+/**
+ * @return how many rings have been scored, either out of the top of the
+ * intake or off the raised lift
+ */
+uint32_t ringsScored();
+
+/**
+ * @return average time rings spent in the intake before leaving it, by any
+ * way out, in seconds
+ */
+double averageRingDwell();
+
+/** @return what happened to every ring that left the intake */
+const Sorting& sorting();
+} // namespace sim::world
@@ -0,0 +1,157 @@
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/util.hpp"
+#include <cmath>
+
+namespace lemlib {
+OdomSensors::OdomSensors(TrackingWheel* vertical1, TrackingWheel* vertical2,
+                         TrackingWheel* horizontal1,
+                         TrackingWheel* horizontal2, pros::Imu* imu)
+  : vertical1(vertical1), vertical2(vertical2), horizontal1(horizontal1),
+    horizontal2(horizontal2), imu(imu) {}
+
+Drivetrain::Drivetrain(pros::MotorGroup* leftMotors,
+                       pros::MotorGroup* rightMotors, float trackWidth,
+                       float wheelDiameter, float rpm, float horizontalDrift)
+  : leftMotors(leftMotors), rightMotors(rightMotors), trackWidth(trackWidth),
+    wheelDiameter(wheelDiameter), rpm(rpm), horizontalDrift(horizontalDrift) {}
+
+Chassis::Chassis(Drivetrain drivetrain, ControllerSettings linearSettings,
+                 ControllerSettings angularSettings, OdomSensors sensors,
+                 DriveCurve* throttleCurve, DriveCurve* steerCurve)
+  : lateralPID(linearSettings.kP, linearSettings.kI, linearSettings.kD,
+               linearSettings.windupRange, true),
+    angularPID(angularSettings.kP, angularSettings.kI, angularSettings.kD,
+               angularSettings.windupRange, true),
+    lateralSettings(linearSettings), angularSettings(angularSettings),
+    drivetrain(drivetrain), sensors(sensors), throttleCurve(throttleCurve),
+    steerCurve(steerCurve),
+    lateralLargeExit(lateralSettings.largeError,
+                     lateralSettings.largeErrorTimeout),
+    lateralSmallExit(lateralSettings.smallError,
+                     lateralSettings.smallErrorTimeout),
+    angularLargeExit(angularSettings.largeError,
+                     angularSettings.largeErrorTimeout),
+    angularSmallExit(angularSettings.smallError,
+                     angularSettings.smallErrorTimeout) {}
+
+void Chassis::calibrate(bool calibrateIMU) {
+  if (calibrateIMU && sensors.imu != nullptr) sensors.imu->reset(true);
+  // substitute the drivetrain for missing vertical tracking wheels
+  if (sensors.vertical1 == nullptr)
+    sensors.vertical1 =
+        new TrackingWheel(drivetrain.leftMotors, drivetrain.wheelDiameter,
+                          -(drivetrain.trackWidth / 2), drivetrain.rpm);
+  if (sensors.vertical2 == nullptr)
+    sensors.vertical2 =
+        new TrackingWheel(drivetrain.rightMotors, drivetrain.wheelDiameter,
+                          drivetrain.trackWidth / 2, drivetrain.rpm);
+  sensors.vertical1->reset();
+  sensors.vertical2->reset();
+  if (sensors.horizontal1 != nullptr) sensors.horizontal1->reset();
+  if (sensors.horizontal2 != nullptr) sensors.horizontal2->reset();
+  setSensors(sensors, drivetrain);
+  init();
+}
+
+void Chassis::setPose(float x, float y, float theta, bool radians) {
+  lemlib::setPose(Pose(x, y, theta), radians);
+}
+
+void Chassis::setPose(Pose pose, bool radians) {
+  lemlib::setPose(pose, radians);
+}
+
+Pose Chassis::getPose(bool radians, bool standardPos) {
+  Pose pose = lemlib::getPose(true);
+  if (standardPos) pose.theta = M_PI_2 - pose.theta;
+  if (!radians) pose.theta = radToDeg(pose.theta);
+  return pose;
+}
+
+void Chassis::waitUntil(float dist) {
+  // give the motion time to start
+  pros::delay(10);
+  while (distTraveled != -1 && distTraveled < dist) pros::delay(10);
+}
+
+void Chassis::waitUntilDone() {
+  do pros::delay(10);
+  while (distTraveled != -1);
+}
+
+void Chassis::setBrakeMode(pros::motor_brake_mode_e mode) {
+  drivetrain.leftMotors->set_brake_mode_all(mode);
+  drivetrain.rightMotors->set_brake_mode_all(mode);
+}
+
+void Chassis::requestMotionStart() {
+  if (isInMotion()) motionQueued = true;
+  else motionRunning = true;
+  // wait until this motion is at the front of the "queue"
+  mutex.take(TIMEOUT_MAX);
+}
+
+void Chassis::endMotion() {
+  // move the "queue" forward by one
+  motionRunning = motionQueued;
+  motionQueued = false;
+  mutex.give();
+}
+
+void Chassis::cancelMotion() { motionRunning = false; }
+
+void Chassis::cancelAllMotions() {
+  motionRunning = false;
+  motionQueued = false;
+}
+
+bool Chassis::isInMotion() const { return motionRunning; }
+
+void Chassis::resetLocalPosition() {
+  setPose(0, 0, getPose().theta);
+}
+
+void Chassis::tank(int left, int right, bool disableDriveCurve) {
+  if (!disableDriveCurve) {
+    left = throttleCurve->curve(left);
+    right = throttleCurve->curve(right);
+  }
+  drivetrain.leftMotors->move(left);
+  drivetrain.rightMotors->move(right);
+}
+
+void Chassis::arcade(int throttle, int turn, bool disableDriveCurve,
+                     float desaturateBias) {
+  if (!disableDriveCurve) {
+    throttle = throttleCurve->curve(throttle);
+    turn = steerCurve->curve(turn);
+  }
+  // desaturate so that turning always has authority
+  if (std::abs(throttle) + std::abs(turn) > 127) {
+    const int oldThrottle = throttle;
+    const int oldTurn = turn;
+    throttle *= (1 - desaturateBias * std::abs(oldTurn / 127.0));
+    turn *= (1 - (1 - desaturateBias) * std::abs(oldThrottle / 127.0));
+  }
+  drivetrain.leftMotors->move(throttle + turn);
+  drivetrain.rightMotors->move(throttle - turn);
+}
+
+void Chassis::curvature(int throttle, int turn, bool disableDriveCurve) {
+  if (throttle == 0) return arcade(throttle, turn, disableDriveCurve);
+  if (!disableDriveCurve) {
+    throttle = throttleCurve->curve(throttle);
+    turn = steerCurve->curve(turn);
+  }
+  float left = throttle + (std::abs(throttle) * turn) / 127.0;
+  float right = throttle - (std::abs(throttle) * turn) / 127.0;
+  const float ratio = std::max(std::fabs(left), std::fabs(right)) / 127.0;
+  if (ratio > 1) {
+    left /= ratio;
+    right /= ratio;
+  }
+  drivetrain.leftMotors->move(left);
+  drivetrain.rightMotors->move(right);
+}
+} // namespace lemlib
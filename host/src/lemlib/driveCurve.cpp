@@ -0,0 +1,18 @@
+#include "lemlib/util.hpp"
+#include <cmath>
+
+namespace lemlib {
+ExpoDriveCurve defaultDriveCurve(0, 0, 1);
+
+ExpoDriveCurve::ExpoDriveCurve(float deadband, float minOutput, float curve)
+  : deadband(deadband), minOutput(minOutput), curveGain(curve) {}
+
+float ExpoDriveCurve::curve(float input) {
+  if (std::fabs(input) <= deadband) return 0;
+  const float g = std::fabs(input) - deadband;
+  const float g127 = 127 - deadband;
+  const float i = std::pow(curveGain, g - 127) * g * sgn(input);
+  const float i127 = std::pow(curveGain, g127 - 127) * g127;
+  return (127.0 - minOutput) / 127 * i * 127 / i127 + minOutput * sgn(input);
+}
+} // namespace lemlib
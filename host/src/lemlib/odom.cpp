@@ -0,0 +1,169 @@
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/util.hpp"
+#include "pros/rtos.hpp"
+#include <cmath>
+
+namespace lemlib {
+namespace {
+OdomSensors odomSensors(nullptr, nullptr, nullptr, nullptr, nullptr);
+Drivetrain drive(nullptr, nullptr, 0, 0, 0, 0);
+// theta is in radians
+Pose odomPose(0, 0, 0);
+Pose odomSpeed(0, 0, 0);
+Pose odomLocalSpeed(0, 0, 0);
+
+pros::Task* trackingTask = nullptr;
+
+float prevVertical = 0;
+float prevVertical1 = 0;
+float prevVertical2 = 0;
+float prevHorizontal = 0;
+float prevHorizontal1 = 0;
+float prevHorizontal2 = 0;
+float prevImu = 0;
+} // namespace
+
+void setSensors(OdomSensors sensors, Drivetrain drivetrain) {
+  odomSensors = sensors;
+  drive = drivetrain;
+}
+
+Pose getPose(bool radians) {
+  if (radians) return odomPose;
+  return Pose(odomPose.x, odomPose.y, radToDeg(odomPose.theta));
+}
+
+void setPose(Pose pose, bool radians) {
+  if (radians) odomPose = pose;
+  else odomPose = Pose(pose.x, pose.y, degToRad(pose.theta));
+}
+
+Pose getSpeed(bool radians) {
+  if (radians) return odomSpeed;
+  return Pose(odomSpeed.x, odomSpeed.y, radToDeg(odomSpeed.theta));
+}
+
+Pose getLocalSpeed(bool radians) {
+  if (radians) return odomLocalSpeed;
+  return Pose(odomLocalSpeed.x, odomLocalSpeed.y,
+              radToDeg(odomLocalSpeed.theta));
+}
+
+Pose estimatePose(float time, bool radians) {
+  const Pose curPose = getPose(true);
+  const Pose localSpeed = getLocalSpeed(true);
+  const Pose deltaLocalPose = localSpeed * time;
+  const float avgHeading = curPose.theta + deltaLocalPose.theta / 2;
+  Pose futurePose = curPose;
+  futurePose.x += deltaLocalPose.y * std::sin(avgHeading);
+  futurePose.y += deltaLocalPose.y * std::cos(avgHeading);
+  futurePose.x += deltaLocalPose.x * -std::cos(avgHeading);
+  futurePose.y += deltaLocalPose.x * std::sin(avgHeading);
+  futurePose.theta += deltaLocalPose.theta;
+  if (!radians) futurePose.theta = radToDeg(futurePose.theta);
+  return futurePose;
+}
+
+void update() {
+  TrackingWheel* vertical1 = odomSensors.vertical1;
+  TrackingWheel* vertical2 = odomSensors.vertical2;
+  TrackingWheel* horizontal1 = odomSensors.horizontal1;
+  TrackingWheel* horizontal2 = odomSensors.horizontal2;
+
+  const float vertical1Raw = vertical1 ? vertical1->getDistanceTraveled() : 0;
+  const float vertical2Raw = vertical2 ? vertical2->getDistanceTraveled() : 0;
+  const float horizontal1Raw =
+      horizontal1 ? horizontal1->getDistanceTraveled() : 0;
+  const float horizontal2Raw =
+      horizontal2 ? horizontal2->getDistanceTraveled() : 0;
+  const float imuRaw =
+      odomSensors.imu ? degToRad(odomSensors.imu->get_rotation()) : 0;
+
+  const float deltaVertical1 = vertical1Raw - prevVertical1;
+  const float deltaVertical2 = vertical2Raw - prevVertical2;
+  const float deltaHorizontal1 = horizontal1Raw - prevHorizontal1;
+  const float deltaHorizontal2 = horizontal2Raw - prevHorizontal2;
+  const float deltaImu = imuRaw - prevImu;
+
+  prevVertical1 = vertical1Raw;
+  prevVertical2 = vertical2Raw;
+  prevHorizontal1 = horizontal1Raw;
+  prevHorizontal2 = horizontal2Raw;
+  prevImu = imuRaw;
+
+  // heading source priority: horizontal wheels, vertical wheels, imu, drive
+  float heading = odomPose.theta;
+  if (horizontal1 != nullptr && horizontal2 != nullptr)
+    heading -= (deltaHorizontal1 - deltaHorizontal2) /
+               (horizontal1->getOffset() - horizontal2->getOffset());
+  else if (vertical1 != nullptr && vertical2 != nullptr &&
+           !vertical1->getType() && !vertical2->getType())
+    heading -= (deltaVertical1 - deltaVertical2) /
+               (vertical1->getOffset() - vertical2->getOffset());
+  else if (odomSensors.imu != nullptr) heading += deltaImu;
+  else if (vertical1 != nullptr && vertical2 != nullptr)
+    heading -= (deltaVertical1 - deltaVertical2) /
+               (vertical1->getOffset() - vertical2->getOffset());
+  const float deltaHeading = heading - odomPose.theta;
+  const float avgHeading = odomPose.theta + deltaHeading / 2;
+
+  TrackingWheel* verticalWheel = nullptr;
+  TrackingWheel* horizontalWheel = nullptr;
+  if (vertical1 != nullptr && !vertical1->getType()) verticalWheel = vertical1;
+  else if (vertical2 != nullptr && !vertical2->getType())
+    verticalWheel = vertical2;
+  else verticalWheel = vertical1;
+  if (horizontal1 != nullptr) horizontalWheel = horizontal1;
+  else if (horizontal2 != nullptr) horizontalWheel = horizontal2;
+
+  const float rawVertical =
+      verticalWheel ? verticalWheel->getDistanceTraveled() : 0;
+  const float rawHorizontal =
+      horizontalWheel ? horizontalWheel->getDistanceTraveled() : 0;
+  const float verticalOffset = verticalWheel ? verticalWheel->getOffset() : 0;
+  const float horizontalOffset =
+      horizontalWheel ? horizontalWheel->getOffset() : 0;
+
+  const float deltaY = rawVertical - prevVertical;
+  const float deltaX = rawHorizontal - prevHorizontal;
+  prevVertical = rawVertical;
+  prevHorizontal = rawHorizontal;
+
+  float localX = deltaX;
+  float localY = deltaY;
+  if (deltaHeading != 0) {
+    localX = 2 * std::sin(deltaHeading / 2) *
+             (deltaX / deltaHeading + horizontalOffset);
+    localY = 2 * std::sin(deltaHeading / 2) *
+             (deltaY / deltaHeading + verticalOffset);
+  }
+
+  const Pose prevPose = odomPose;
+
+  odomPose.x += localY * std::sin(avgHeading);
+  odomPose.y += localY * std::cos(avgHeading);
+  odomPose.x += localX * -std::cos(avgHeading);
+  odomPose.y += localX * std::sin(avgHeading);
+  odomPose.theta = heading;
+
+  odomSpeed.x = ema((odomPose.x - prevPose.x) / 0.01, odomSpeed.x, 0.95);
+  odomSpeed.y = ema((odomPose.y - prevPose.y) / 0.01, odomSpeed.y, 0.95);
+  odomSpeed.theta =
+      ema((odomPose.theta - prevPose.theta) / 0.01, odomSpeed.theta, 0.95);
+
+  odomLocalSpeed.x = ema(localX / 0.01, odomLocalSpeed.x, 0.95);
+  odomLocalSpeed.y = ema(localY / 0.01, odomLocalSpeed.y, 0.95);
+  odomLocalSpeed.theta =
+      ema(deltaHeading / 0.01, odomLocalSpeed.theta, 0.95);
+}
+
+void init() {
+  if (trackingTask != nullptr) return;
+  trackingTask = new pros::Task {[] {
+    while (true) {
+      update();
+      pros::delay(10);
+    }
+  }};
+}
+} // namespace lemlib
@@ -0,0 +1,49 @@
+#include "lemlib/chassis/trackingWheel.hpp"
+#include <cmath>
+
+namespace lemlib {
+TrackingWheel::TrackingWheel(pros::adi::Encoder* encoder, float wheelDiameter,
+                             float distance, float gearRatio)
+  : diameter(wheelDiameter), distance(distance), encoder(encoder),
+    gearRatio(gearRatio) {}
+
+TrackingWheel::TrackingWheel(pros::Rotation* encoder, float wheelDiameter,
+                             float distance, float gearRatio)
+  : diameter(wheelDiameter), distance(distance), rotation(encoder),
+    gearRatio(gearRatio) {}
+
+TrackingWheel::TrackingWheel(pros::MotorGroup* motors, float wheelDiameter,
+                             float distance, float rpm)
+  : diameter(wheelDiameter), distance(distance), rpm(rpm), motors(motors) {
+  motors->set_encoder_units_all(pros::MotorEncoderUnits::rotations);
+}
+
+void TrackingWheel::reset() {
+  if (rotation != nullptr) rotation->reset_position();
+  if (motors != nullptr) motors->tare_position_all();
+}
+
+float TrackingWheel::getDistanceTraveled() {
+  if (rotation != nullptr)
+    return float(rotation->get_position()) * diameter * M_PI / 36000 /
+           gearRatio;
+  if (motors != nullptr) {
+    // average the motors, scaled by the cartridge to wheel ratio
+    const std::vector<double> positions = motors->get_position_all();
+    const std::vector<pros::MotorGears> gearsets = motors->get_gearing_all();
+    float total = 0;
+    for (size_t i = 0; i < positions.size(); ++i) {
+      float cartridge = 200;
+      if (gearsets[i] == pros::MotorGears::red) cartridge = 100;
+      else if (gearsets[i] == pros::MotorGears::blue) cartridge = 600;
+      total += positions[i] * diameter * M_PI * (rpm / cartridge);
+    }
+    return positions.empty() ? 0 : total / positions.size();
+  }
+  return 0;
+}
+
+float TrackingWheel::getOffset() { return distance; }
+
+int TrackingWheel::getType() { return motors != nullptr ? 1 : 0; }
+} // namespace lemlib
@@ -0,0 +1,338 @@
+#include "main.h"
+#include "logBuffer.h"
+#include "robot.h"
+#include "sim/devices.h"
+#include "sim/kernel.h"
+#include "sim/world.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+/**
+ * Runs the robot code against the simulated robot, driving the controller
+ * through a short scripted match, then reports how the tasks spent their time.
+ * With --follow, follows static/example.path instead. With --trajectory,
+ * tracks static/example.traj instead. With --characterize,
+ * sweeps the lift to fit its feedforward instead. With --sort, intakes a
+ * random stream of red and blue rings for the given time while sorting out
+ * one color instead. With --chain, drives a chain of moves through the motion
+ * queue, once stopping after every move and once blending them, instead.
+ *
+ * usage: sim [seconds] [--cpu-scale scale]
+ *            [--follow | --trajectory | --characterize | --sort red|blue |
+ *             --chain]
+ */
+
+ASSET(example_path);
+ASSET(example_traj);
+
+namespace {
+int32_t buttonIndex(pros::controller_digital_e_t button) {
+  return button - pros::E_CONTROLLER_DIGITAL_L1;
+}
+
+void press(pros::controller_digital_e_t button, bool pressed = true) {
+  sim::controller().digital.at(buttonIndex(button)) = pressed;
+}
+
+void drive(int32_t left, int32_t right) {
+  sim::controller().analog.at(pros::E_CONTROLLER_ANALOG_LEFT_Y) = left;
+  sim::controller().analog.at(pros::E_CONTROLLER_ANALOG_RIGHT_Y) = right;
+}
+
+/** @brief taps a button for long enough for opcontrol to see it */
+void tap(pros::controller_digital_e_t button) {
+  press(button);
+  pros::delay(60);
+  press(button, false);
+}
+
+/** @brief one cycle of the scripted match, takes 10 seconds */
+void cycle() {
+  // drive up to a stack while grabbing the mogo
+  drive(100, 100);
+  tap(pros::E_CONTROLLER_DIGITAL_R1);
+  pros::delay(1000);
+  drive(60, -60);
+  pros::delay(500);
+  drive(0, 0);
+
+  // intake a few rings into the lift, the lift should take them when raised
+  press(pros::E_CONTROLLER_DIGITAL_R2);
+  for (int i = 0; i < 3; ++i) {
+    sim::world::feedRing(i % 2 ? 220 : 10);
+    pros::delay(1000);
+  }
+  press(pros::E_CONTROLLER_DIGITAL_R2, false);
+
+  tap(pros::E_CONTROLLER_DIGITAL_UP);
+  pros::delay(1500);
+  tap(pros::E_CONTROLLER_DIGITAL_UP);
+  pros::delay(1500);
+  tap(pros::E_CONTROLLER_DIGITAL_DOWN);
+  pros::delay(1000);
+  tap(pros::E_CONTROLLER_DIGITAL_DOWN);
+  pros::delay(1000);
+
+  // back off and let go of the mogo
+  drive(-100, -100);
+  pros::delay(500);
+  drive(0, 0);
+  tap(pros::E_CONTROLLER_DIGITAL_R1);
+  pros::delay(1000 - 5 * 60);
+}
+
+/**
+ * @brief animates every strip as fast as it can, the compositor should cap the
+ * sends per port
+ */
+void animateLeds() {
+  CycleEffect cycle {0x0000FF, 0xFF00FF, 20};
+  while (true) {
+    const uint32_t now = pros::millis();
+    bot.leftUnderGlow.show(cycle, now);
+    bot.rightUnderGlow.show(cycle, now);
+    pros::delay(5);
+  }
+}
+
+/** @brief follows the example path from the origin */
+void follow() {
+  bot.odom.setPose({0, 0, 0});
+  const Path path {example_path};
+  const uint32_t start = pros::millis();
+  bot.follow(path, 10, 5000, true, false);
+  const sim::world::Pose& pose = sim::world::pose();
+  // JerryIO pads the end of the path with points that have no speed
+  uint32_t last = 0;
+  while (last + 1 < path.size() && path.speed(last) != 0) ++last;
+  std::printf("followed %u points in %ums, stopped %.2fin from the end\n",
+              path.size(), pros::millis() - start,
+              std::hypot(pose.x - path.x(last), pose.y - path.y(last)));
+}
+
+/** @brief tracks the example trajectory from the origin */
+void trackTrajectory() {
+  bot.odom.setPose({0, 0, 0});
+  const Trajectory trajectory {example_traj};
+  const uint32_t start = pros::millis();
+  const MotionHandle handle = bot.follow(trajectory, 5000);
+  // how far the robot falls behind or strays from where it should be
+  float worst = 0;
+  while (!handle.isDone()) {
+    const TrajectoryState target =
+        trajectory.sample((pros::millis() - start) / 1000.0f);
+    const sim::world::Pose& pose = sim::world::pose();
+    worst = std::max<float>(worst,
+                            std::hypot(pose.x - target.x, pose.y - target.y));
+    pros::delay(10);
+  }
+  const uint32_t time = pros::millis() - start;
+  // settling after the motors stop driving
+  pros::delay(500);
+  const TrajectoryState end = trajectory.sample(trajectory.duration());
+  const sim::world::Pose& pose = sim::world::pose();
+  std::printf("tracked the trajectory in %ums of %.0fms, at most %.2fin off "
+              "it, stopped %.2fin from the end\n",
+              time, trajectory.duration() * 1000, worst,
+              std::hypot(pose.x - end.x, pose.y - end.y));
+}
+
+/** @brief runs the lift's characterization sweep until it's done */
+void characterize() {
+  const uint32_t start = pros::millis();
+  bot.lift.characterize();
+  // the sweep starts on the lift's next update
+  pros::delay(20);
+  while (bot.lift.getState() == Lift::State::CHARACTERIZE) pros::delay(20);
+  std::printf("characterized the lift in %ums\n", pros::millis() - start);
+}
+
+/**
+ * @brief intakes red and blue rings in a random order at random intervals,
+ * stopping the intake now and then, while the intake throws out color
+ */
+void sortRings(RingColor color, double seconds) {
+  bot.intake.setSortColor(color);
+  // the same stream every run
+  std::mt19937 random {781};
+  std::uniform_real_distribution<double> hueNoise(-15, 15);
+  std::uniform_int_distribution<uint32_t> interval(250, 750);
+  uint32_t fed[2] = {};
+  bot.intake.intake();
+  const uint32_t end = pros::millis() + seconds * 1000;
+  while (pros::millis() < end) {
+    const bool red = random() % 2;
+    const double hue = (red ? 0 : 220) + hueNoise(random);
+    sim::world::feedRing(hue < 0 ? hue + 360 : hue);
+    ++fed[red];
+    pros::delay(interval(random));
+    if (random() % 6 == 0) {
+      bot.intake.stop();
+      pros::delay(300);
+      bot.intake.intake();
+    }
+  }
+  // let the last rings through
+  pros::delay(3000);
+  bot.intake.stop();
+
+  const sim::world::Sorting& sorting = sim::world::sorting();
+  const bool sortRed = color == RingColor::RED;
+  std::printf("fed %u red and %u blue rings, sorting out %s\n", fed[1], fed[0],
+              sortRed ? "red" : "blue");
+  std::printf("sort: %u of %u wrong rings thrown out, %u scored\n",
+              sortRed ? sorting.redEjected : sorting.blueEjected,
+              fed[sortRed], sortRed ? sorting.redScored : sorting.blueScored);
+  std::printf("sort: %u of %u right rings scored, %u thrown out\n",
+              sortRed ? sorting.blueScored : sorting.redScored, fed[!sortRed],
+              sortRed ? sorting.blueEjected : sorting.redEjected);
+  std::printf("sort: %u pulses, %u rings lost out the front, %u on the lift, "
+              "%zu left in the intake\n",
+              bot.intake.getEjected(), sorting.lost, sim::world::ringsOnLift(),
+              sim::world::rings().size());
+}
+
+/** @brief y of the robot on the first step of the move back down */
+float moveStartedAt = 0;
+/** @brief y of the robot when the intake was started by a callback */
+float intakeStartedAt = 0;
+
+/**
+ * @brief queues a loop of moves and turns that ends back at the origin,
+ * starting the intake 18in into the move back down
+ * @param stop whether to wait for each motion before queueing the next
+ */
+uint32_t driveChain(bool stop) {
+  const uint32_t start = pros::millis();
+  const auto wait = [stop](MotionHandle handle) {
+    if (stop) handle.await();
+  };
+  wait(bot.motions.moveToPoint(0, 36, 3000));
+  wait(bot.motions.moveToPoint(24, 60, 3000));
+  wait(bot.motions.moveToPoint(48, 60, 3000));
+  wait(bot.motions.turnToHeading(180, 2000));
+  wait(bot.motions.moveToPoint(48, 24, 3000)
+           .onProgress(0, [] { moveStartedAt = bot.odom.getPose().y; })
+           .onDistance(18, [] {
+             intakeStartedAt = bot.odom.getPose().y;
+             bot.intake.intake();
+           }));
+  wait(bot.motions.moveToPoint(0, 0, 3000));
+  bot.motions.turnToHeading(0, 2000).await();
+  bot.intake.stop();
+  return pros::millis() - start;
+}
+
+/** @brief drives the chain stopping after every move, then blending them */
+void chain() {
+  bot.odom.setPose({0, 0, 0});
+  for (const bool stop : {true, false}) {
+    const uint32_t time = driveChain(stop);
+    const lemlib::Pose pose = bot.odom.getPose();
+    std::printf("%s: %ums, ended at x %.2f y %.2f theta %.2f, intake started "
+                "%.2fin into the move\n",
+                stop ? "stopping" : "blended", time, pose.x, pose.y,
+                pose.theta, moveStartedAt - intakeStartedAt);
+    // the chain ends about where it started, so the next run starts there
+    pros::delay(500);
+  }
+}
+
+void report(double simSeconds, double wallSeconds) {
+  std::printf("simulated %.1fs in %.3fs of wall time (%.0fx real time)\n",
+              simSeconds, wallSeconds, simSeconds / wallSeconds);
+
+  std::vector<sim::Kernel::Task> tasks = sim::Kernel::get().tasks();
+  std::sort(tasks.begin(), tasks.end(), [](const auto& a, const auto& b) {
+    return a.cpuTime > b.cpuTime;
+  });
+  std::printf("\n%-24s %4s %12s %8s\n", "task", "prio", "cpu (us)", "cpu %");
+  for (const sim::Kernel::Task& task : tasks) {
+    const char* name = task.name.empty() ? "(unnamed)" : task.name.c_str();
+    std::printf("%-24s %4u %12llu %7.3f%%\n", name,
+                task.priority, (unsigned long long)task.cpuTime,
+                task.cpuTime / (simSeconds * 1e6) * 100);
+  }
+
+  std::printf("\n%-10s %6s %8s %10s %10s %10s %6s\n", "subsystem", "period",
+              "updates", "avg (us)", "max (us)", "jitter", "missed");
+  const std::pair<const char*, const Subsystem*> subsystems[] = {
+      {"sampler", &bot.sampler}, {"rings", &bot.ringDetector},
+      {"input", &bot.input},     {"lift", &bot.lift},
+      {"intake", &bot.intake},   {"mogo", &bot.mogo}};
+  for (const auto& [name, subsystem] : subsystems) {
+    const SubsystemStats& stats = subsystem->getStats();
+    std::printf("%-10s %6u %8u %10.1f %10u %10u %6u\n", name,
+                subsystem->getPeriod(), stats.updates,
+                stats.updates ? double(stats.totalExecTime) / stats.updates : 0,
+                stats.maxExecTime, stats.maxJitter, stats.missedDeadlines);
+  }
+
+  const sim::world::Pose& pose = sim::world::pose();
+  const lemlib::Pose odom = bot.odom.getPose();
+  std::printf("\npose: x %.2f y %.2f theta %.2f\n", pose.x, pose.y,
+              pose.theta * 180 / M_PI);
+  std::printf("odom: x %.2f y %.2f theta %.2f\n", odom.x, odom.y, odom.theta);
+  std::printf("lift: %.2f deg\n", sim::world::liftAngle());
+  std::printf("rings: %zu in the intake, %u on the lift, %u scored, %.0fms "
+              "average in the intake\n",
+              sim::world::rings().size(), sim::world::ringsOnLift(),
+              sim::world::ringsScored(), sim::world::averageRingDwell() * 1000);
+  const LogBuffer::Stats log = LogBuffer::get()->getStats();
+  std::printf("log: %u written, %u dropped, %u contended\n", log.written,
+              log.dropped, log.contended);
+  std::printf("led sends: left underglow %u, right underglow %u\n",
+              sim::led(10, 1).flushes, sim::led(10, 5).flushes);
+  std::printf("lcd (%u prints):\n", sim::lcd().prints);
+  for (const std::string& line : sim::lcd().lines)
+    if (!line.empty()) std::printf("  %s\n", line.c_str());
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  double seconds = 30;
+  bool followPath = false;
+  bool followTrajectory = false;
+  bool characterizeLift = false;
+  bool chainMoves = false;
+  RingColor sortColor = RingColor::NONE;
+  for (int i = 1; i < argc; ++i) {
+    if (!std::strcmp(argv[i], "--cpu-scale") && i + 1 < argc)
+      sim::Kernel::get().setCpuScale(std::atof(argv[++i]));
+    else if (!std::strcmp(argv[i], "--follow")) followPath = true;
+    else if (!std::strcmp(argv[i], "--trajectory")) followTrajectory = true;
+    else if (!std::strcmp(argv[i], "--characterize")) characterizeLift = true;
+    else if (!std::strcmp(argv[i], "--chain")) chainMoves = true;
+    else if (!std::strcmp(argv[i], "--sort") && i + 1 < argc)
+      sortColor = std::strcmp(argv[++i], "red") ? RingColor::BLUE
+                                                : RingColor::RED;
+    else seconds = std::atof(argv[i]);
+  }
+
+  const auto wallStart = std::chrono::steady_clock::now();
+  sim::world::init();
+
+  initialize();
+  if (followPath) follow();
+  else if (followTrajectory) trackTrajectory();
+  else if (characterizeLift) characterize();
+  else if (chainMoves) chain();
+  else if (sortColor != RingColor::NONE) sortRings(sortColor, seconds);
+  else {
+    pros::Task opcontrolTask {opcontrol, "opcontrol"};
+    pros::Task ledTask {animateLeds, "leds"};
+    const uint32_t end = pros::millis() + seconds * 1000;
+    while (pros::millis() < end) cycle();
+  }
+
+  const double wallSeconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                    wallStart)
+          .count();
+  report(pros::millis() / 1000.0, wallSeconds);
+  sim::Kernel::get().exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,122 @@
+#include "pros/adi.hpp"
+#include "sim/devices.h"
+
+namespace pros::adi {
+namespace {
+/** @brief converts 1-8, 'a'-'h' and 'A'-'H' to 1-8 */
+std::uint8_t normalize(std::uint8_t adiPort) {
+  if (adiPort >= 'a' && adiPort <= 'h') return adiPort - 'a' + 1;
+  if (adiPort >= 'A' && adiPort <= 'H') return adiPort - 'A' + 1;
+  return adiPort;
+}
+} // namespace
+
+Port::Port(std::uint8_t adi_port, adi_port_config_e_t type)
+  : _smart_port(INTERNAL_ADI_PORT), _adi_port(normalize(adi_port)) {
+  set_config(type);
+}
+
+Port::Port(ext_adi_port_pair_t port_pair, adi_port_config_e_t type)
+  : _smart_port(port_pair.first), _adi_port(normalize(port_pair.second)) {
+  set_config(type);
+}
+
+std::int32_t Port::get_config() const {
+  return sim::adi(_smart_port, _adi_port).config;
+}
+
+std::int32_t Port::get_value() const {
+  return sim::adi(_smart_port, _adi_port).value;
+}
+
+std::int32_t Port::set_config(adi_port_config_e_t type) const {
+  sim::adi(_smart_port, _adi_port).config = type;
+  return 1;
+}
+
+std::int32_t Port::set_value(std::int32_t value) const {
+  sim::adi(_smart_port, _adi_port).value = value;
+  return 1;
+}
+
+ext_adi_port_tuple_t Port::get_port() const {
+  return {_smart_port, _adi_port, 0};
+}
+
+DigitalOut::DigitalOut(std::uint8_t adi_port, bool init_state)
+  : Port(adi_port, E_ADI_DIGITAL_OUT) {
+  set_value(init_state);
+}
+
+DigitalOut::DigitalOut(ext_adi_port_pair_t port_pair, bool init_state)
+  : Port(port_pair, E_ADI_DIGITAL_OUT) {
+  set_value(init_state);
+}
+
+Pneumatics::Pneumatics(std::uint8_t adi_port, bool start_extended,
+                       bool extended_is_low)
+  : DigitalOut(adi_port, start_extended != extended_is_low),
+    state(start_extended != extended_is_low),
+    extended_is_low(extended_is_low) {}
+
+Pneumatics::Pneumatics(ext_adi_port_pair_t port_pair, bool start_extended,
+                       bool extended_is_low)
+  : DigitalOut(port_pair, start_extended != extended_is_low),
+    state(start_extended != extended_is_low),
+    extended_is_low(extended_is_low) {}
+
+std::int32_t Pneumatics::extend() {
+  state = !extended_is_low;
+  return set_value(state);
+}
+
+std::int32_t Pneumatics::retract() {
+  state = extended_is_low;
+  return set_value(state);
+}
+
+std::int32_t Pneumatics::toggle() {
+  return is_extended() ? retract() : extend();
+}
+
+bool Pneumatics::is_extended() const { return state != extended_is_low; }
+
+Led::Led(std::uint8_t adi_port, std::uint32_t length)
+  : Port(adi_port, E_ADI_DIGITAL_OUT), _buffer(length, 0) {}
+
+Led::Led(ext_adi_port_pair_t port_pair, std::uint32_t length)
+  : Port(port_pair, E_ADI_DIGITAL_OUT), _buffer(length, 0) {}
+
+std::uint32_t& Led::operator[](size_t i) { return _buffer[i]; }
+
+std::int32_t Led::clear_all() {
+  std::fill(_buffer.begin(), _buffer.end(), 0);
+  return update();
+}
+
+std::int32_t Led::clear() { return clear_all(); }
+
+std::int32_t Led::update() const {
+  sim::Led& led = sim::led(_smart_port, _adi_port);
+  led.pixels = _buffer;
+  ++led.flushes;
+  return 1;
+}
+
+std::int32_t Led::set_all(uint32_t color) {
+  std::fill(_buffer.begin(), _buffer.end(), color);
+  return update();
+}
+
+std::int32_t Led::set_pixel(uint32_t color, uint32_t pixel_position) {
+  if (pixel_position >= _buffer.size()) return PROS_ERR;
+  _buffer[pixel_position] = color;
+  return update();
+}
+
+std::int32_t Led::clear_pixel(uint32_t pixel_position) {
+  return set_pixel(0, pixel_position);
+}
+
+std::int32_t Led::length() { return _buffer.size(); }
+} // namespace pros::adi
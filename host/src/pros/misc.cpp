@@ -0,0 +1,109 @@
+#include "pros/misc.hpp"
+#include "sim/devices.h"
+#include <cstdarg>
+#include <cstdio>
+
+namespace pros::v5 {
+namespace {
+/** last state seen by get_digital_new_press, per button */
+std::array<bool, 12> lastPressed {};
+
+std::size_t buttonIndex(controller_digital_e_t button) {
+  return button - E_CONTROLLER_DIGITAL_L1;
+}
+} // namespace
+
+Controller::Controller(controller_id_e_t id) : _id(id) {}
+
+std::int32_t Controller::is_connected(void) {
+  return _id == E_CONTROLLER_MASTER;
+}
+
+std::int32_t Controller::get_analog(controller_analog_e_t channel) {
+  if (_id != E_CONTROLLER_MASTER) return 0;
+  return sim::controller().analog.at(channel);
+}
+
+std::int32_t Controller::get_battery_capacity(void) { return 100; }
+
+std::int32_t Controller::get_battery_level(void) { return 100; }
+
+std::int32_t Controller::get_digital(controller_digital_e_t button) {
+  if (_id != E_CONTROLLER_MASTER) return 0;
+  return sim::controller().digital.at(buttonIndex(button));
+}
+
+std::int32_t Controller::get_digital_new_press(controller_digital_e_t button) {
+  if (_id != E_CONTROLLER_MASTER) return 0;
+  const bool pressed = sim::controller().digital.at(buttonIndex(button));
+  const bool wasPressed = lastPressed[buttonIndex(button)];
+  lastPressed[buttonIndex(button)] = pressed;
+  return pressed && !wasPressed;
+}
+
+std::int32_t Controller::set_text(std::uint8_t, std::uint8_t, const char*) {
+  return 1;
+}
+
+std::int32_t Controller::set_text(std::uint8_t, std::uint8_t,
+                                  const std::string&) {
+  return 1;
+}
+
+std::int32_t Controller::clear_line(std::uint8_t) { return 1; }
+
+std::int32_t Controller::rumble(const char*) { return 1; }
+
+std::int32_t Controller::clear(void) { return 1; }
+} // namespace pros::v5
+
+namespace pros::competition {
+std::uint8_t get_status(void) { return 0; }
+
+std::uint8_t is_autonomous(void) { return 0; }
+
+std::uint8_t is_connected(void) { return 0; }
+
+std::uint8_t is_disabled(void) { return 0; }
+
+std::uint8_t is_field_control(void) { return 0; }
+
+std::uint8_t is_competition_switch(void) { return 0; }
+} // namespace pros::competition
+
+// pros/llemu.h only provides weak stubs, so these are declared by hand
+extern "C" {
+bool lcd_print(int16_t line, const char* fmt, ...) {
+  if (line < 0 || line >= int16_t(sim::lcd().lines.size())) return false;
+  char text[64];
+  va_list args;
+  va_start(args, fmt);
+  std::vsnprintf(text, sizeof(text), fmt, args);
+  va_end(args);
+  sim::lcd().lines[line] = text;
+  ++sim::lcd().prints;
+  return true;
+}
+
+bool lcd_set_text(int16_t line, const char* text) {
+  return lcd_print(line, "%s", text);
+}
+
+bool lcd_clear_line(int16_t line) { return lcd_print(line, ""); }
+
+bool lcd_initialize(void) { return true; }
+
+bool lcd_is_initialized(void) { return true; }
+}
+
+namespace pros::lcd {
+bool initialize(void) { return lcd_initialize(); }
+
+bool is_initialized(void) { return lcd_is_initialized(); }
+
+bool set_text(std::int16_t line, std::string text) {
+  return lcd_set_text(line, text.c_str());
+}
+
+bool clear_line(std::int16_t line) { return lcd_clear_line(line); }
+} // namespace pros::lcd
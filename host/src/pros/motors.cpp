@@ -0,0 +1,494 @@
+#include "pros/motor_group.hpp"
+#include "pros/error.h"
+#include "sim/devices.h"
+#include <cerrno>
+#include <cstdlib>
+
+namespace pros::v5 {
+namespace {
+/** encoder ticks per output revolution, indexed by gearset */
+constexpr double TICKS_PER_REV[] = {1800, 900, 300};
+constexpr double FREE_SPEED[] = {100, 200, 600};
+
+sim::Motor& simMotor(std::int8_t port) { return sim::motor(std::abs(port)); }
+
+/** @return 1 for a forward motor, -1 for a reversed one */
+int direction(std::int8_t port) { return port < 0 ? -1 : 1; }
+
+double toUnits(const sim::Motor& motor, double degrees) {
+  switch (motor.encoderUnits) {
+    case 1: return degrees / 360.0;
+    case 2: return degrees / 360.0 * TICKS_PER_REV[motor.gearing];
+    default: return degrees;
+  }
+}
+
+double fromUnits(const sim::Motor& motor, double position) {
+  switch (motor.encoderUnits) {
+    case 1: return position * 360.0;
+    case 2: return position / TICKS_PER_REV[motor.gearing] * 360.0;
+    default: return position;
+  }
+}
+} // namespace
+
+MotorGroup::MotorGroup(const std::initializer_list<std::int8_t> ports,
+                       const MotorGears gearset,
+                       const MotorUnits encoder_units)
+  : MotorGroup(std::vector<std::int8_t>(ports), gearset, encoder_units) {}
+
+MotorGroup::MotorGroup(const std::vector<std::int8_t>& ports,
+                       const MotorGears gearset,
+                       const MotorUnits encoder_units)
+  : _ports(ports) {
+  if (gearset != MotorGears::invalid) set_gearing_all(gearset);
+  if (encoder_units != MotorUnits::invalid)
+    set_encoder_units_all(encoder_units);
+}
+
+MotorGroup::MotorGroup(AbstractMotor& motor_group)
+  : _ports(motor_group.get_port_all()) {}
+
+// a helper for all the getters that have an _all counterpart
+#define FOR_EACH_PORT(type, expr)                                              \
+  std::vector<type> out;                                                       \
+  for (std::int8_t port : _ports) out.push_back(expr);                         \
+  return out;
+
+#define AT_INDEX(expr)                                                         \
+  if (index >= _ports.size()) {                                                \
+    errno = EOVERFLOW;                                                         \
+    return {};                                                                 \
+  }                                                                            \
+  const std::int8_t port = _ports[index];                                      \
+  return expr;
+
+std::int32_t MotorGroup::move(std::int32_t voltage) const {
+  return move_voltage(voltage * 12000 / 127);
+}
+
+std::int32_t MotorGroup::move_absolute(const double position,
+                                       const std::int32_t velocity) const {
+  for (std::int8_t port : _ports) {
+    sim::Motor& motor = simMotor(port);
+    motor.mode = sim::Motor::Mode::POSITION;
+    motor.braking = false;
+    motor.targetPosition = direction(port) * fromUnits(motor, position);
+    motor.targetVelocity = velocity;
+  }
+  return 1;
+}
+
+std::int32_t MotorGroup::move_relative(const double position,
+                                       const std::int32_t velocity) const {
+  for (std::int8_t port : _ports) {
+    sim::Motor& motor = simMotor(port);
+    motor.mode = sim::Motor::Mode::POSITION;
+    motor.braking = false;
+    motor.targetPosition += direction(port) * fromUnits(motor, position);
+    motor.targetVelocity = velocity;
+  }
+  return 1;
+}
+
+std::int32_t MotorGroup::move_velocity(const std::int32_t velocity) const {
+  for (std::int8_t port : _ports) {
+    sim::Motor& motor = simMotor(port);
+    motor.mode = sim::Motor::Mode::VELOCITY;
+    motor.braking = false;
+    motor.targetVelocity = direction(port) * velocity;
+  }
+  return 1;
+}
+
+std::int32_t MotorGroup::move_voltage(const std::int32_t voltage) const {
+  for (std::int8_t port : _ports) {
+    sim::Motor& motor = simMotor(port);
+    motor.mode = sim::Motor::Mode::VOLTAGE;
+    motor.braking = false;
+    motor.voltage = direction(port) * voltage;
+  }
+  return 1;
+}
+
+std::int32_t MotorGroup::brake(void) const {
+  for (std::int8_t port : _ports) {
+    sim::Motor& motor = simMotor(port);
+    motor.mode = sim::Motor::Mode::VOLTAGE;
+    motor.voltage = 0;
+    motor.braking = true;
+  }
+  return 1;
+}
+
+std::int32_t
+MotorGroup::modify_profiled_velocity(const std::int32_t velocity) const {
+  for (std::int8_t port : _ports) simMotor(port).targetVelocity = velocity;
+  return 1;
+}
+
+double MotorGroup::get_target_position(const std::uint8_t index) const {
+  AT_INDEX(direction(port) *
+           toUnits(simMotor(port), simMotor(port).targetPosition))
+}
+
+std::vector<double> MotorGroup::get_target_position_all(void) const {
+  FOR_EACH_PORT(double,
+                direction(port) *
+                    toUnits(simMotor(port), simMotor(port).targetPosition))
+}
+
+std::int32_t MotorGroup::get_target_velocity(const std::uint8_t index) const {
+  AT_INDEX(std::int32_t(direction(port) * simMotor(port).targetVelocity))
+}
+
+std::vector<std::int32_t> MotorGroup::get_target_velocity_all(void) const {
+  FOR_EACH_PORT(std::int32_t,
+                std::int32_t(direction(port) * simMotor(port).targetVelocity))
+}
+
+double MotorGroup::get_actual_velocity(const std::uint8_t index) const {
+  AT_INDEX(direction(port) * simMotor(port).velocity)
+}
+
+std::vector<double> MotorGroup::get_actual_velocity_all(void) const {
+  FOR_EACH_PORT(double, direction(port) * simMotor(port).velocity)
+}
+
+std::int32_t MotorGroup::get_current_draw(const std::uint8_t index) const {
+  AT_INDEX(std::int32_t(std::abs(simMotor(port).voltage) / 12000.0 * 2500))
+}
+
+std::vector<std::int32_t> MotorGroup::get_current_draw_all(void) const {
+  FOR_EACH_PORT(std::int32_t,
+                std::int32_t(std::abs(simMotor(port).voltage) / 12000.0 * 2500))
+}
+
+std::int32_t MotorGroup::get_direction(const std::uint8_t index) const {
+  AT_INDEX(direction(port) * simMotor(port).velocity < 0 ? -1 : 1)
+}
+
+std::vector<std::int32_t> MotorGroup::get_direction_all(void) const {
+  FOR_EACH_PORT(std::int32_t,
+                direction(port) * simMotor(port).velocity < 0 ? -1 : 1)
+}
+
+double MotorGroup::get_efficiency(const std::uint8_t index) const {
+  AT_INDEX(port == 0 ? 0.0 : 100.0)
+}
+
+std::vector<double> MotorGroup::get_efficiency_all(void) const {
+  FOR_EACH_PORT(double, port == 0 ? 0.0 : 100.0)
+}
+
+std::uint32_t MotorGroup::get_faults(const std::uint8_t index) const {
+  AT_INDEX(std::uint32_t(port == 0))
+}
+
+std::vector<std::uint32_t> MotorGroup::get_faults_all(void) const {
+  FOR_EACH_PORT(std::uint32_t, std::uint32_t(port == 0))
+}
+
+std::uint32_t MotorGroup::get_flags(const std::uint8_t index) const {
+  AT_INDEX(std::uint32_t(port == 0))
+}
+
+std::vector<std::uint32_t> MotorGroup::get_flags_all(void) const {
+  FOR_EACH_PORT(std::uint32_t, std::uint32_t(port == 0))
+}
+
+double MotorGroup::get_position(const std::uint8_t index) const {
+  AT_INDEX(direction(port) * toUnits(simMotor(port), simMotor(port).position))
+}
+
+std::vector<double> MotorGroup::get_position_all(void) const {
+  FOR_EACH_PORT(double, direction(port) *
+                            toUnits(simMotor(port), simMotor(port).position))
+}
+
+double MotorGroup::get_power(const std::uint8_t index) const {
+  AT_INDEX(std::abs(simMotor(port).voltage) / 1000.0 * 2.5 / 12.0 *
+           std::abs(simMotor(port).voltage) / 1000.0)
+}
+
+std::vector<double> MotorGroup::get_power_all(void) const {
+  FOR_EACH_PORT(double, std::abs(simMotor(port).voltage) / 1000.0 * 2.5 /
+                            12.0 * std::abs(simMotor(port).voltage) / 1000.0)
+}
+
+std::int32_t MotorGroup::get_raw_position(std::uint32_t* const timestamp,
+                                          const std::uint8_t index) const {
+  if (timestamp != nullptr) *timestamp = c::millis();
+  AT_INDEX(std::int32_t(direction(port) * simMotor(port).position / 360.0 *
+                        TICKS_PER_REV[simMotor(port).gearing]))
+}
+
+std::vector<std::int32_t>
+MotorGroup::get_raw_position_all(std::uint32_t* const timestamp) const {
+  if (timestamp != nullptr) *timestamp = c::millis();
+  FOR_EACH_PORT(std::int32_t,
+                std::int32_t(direction(port) * simMotor(port).position /
+                             360.0 * TICKS_PER_REV[simMotor(port).gearing]))
+}
+
+double MotorGroup::get_temperature(const std::uint8_t index) const {
+  AT_INDEX(simMotor(port).temperature)
+}
+
+std::vector<double> MotorGroup::get_temperature_all(void) const {
+  FOR_EACH_PORT(double, simMotor(port).temperature)
+}
+
+double MotorGroup::get_torque(const std::uint8_t index) const {
+  AT_INDEX(2.1 * simMotor(port).voltage / 12000.0 *
+           (1 - std::abs(simMotor(port).velocity) / simMotor(port).freeSpeed))
+}
+
+std::vector<double> MotorGroup::get_torque_all(void) const {
+  FOR_EACH_PORT(double, 2.1 * simMotor(port).voltage / 12000.0 *
+                            (1 - std::abs(simMotor(port).velocity) /
+                                     simMotor(port).freeSpeed))
+}
+
+std::int32_t MotorGroup::get_voltage(const std::uint8_t index) const {
+  AT_INDEX(direction(port) * simMotor(port).voltage)
+}
+
+std::vector<std::int32_t> MotorGroup::get_voltage_all(void) const {
+  FOR_EACH_PORT(std::int32_t, direction(port) * simMotor(port).voltage)
+}
+
+std::int32_t MotorGroup::is_over_current(const std::uint8_t index) const {
+  AT_INDEX(std::int32_t(port == 0))
+}
+
+std::vector<std::int32_t> MotorGroup::is_over_current_all(void) const {
+  FOR_EACH_PORT(std::int32_t, std::int32_t(port == 0))
+}
+
+std::int32_t MotorGroup::is_over_temp(const std::uint8_t index) const {
+  AT_INDEX(std::int32_t(simMotor(port).temperature > 55))
+}
+
+std::vector<std::int32_t> MotorGroup::is_over_temp_all(void) const {
+  FOR_EACH_PORT(std::int32_t, std::int32_t(simMotor(port).temperature > 55))
+}
+
+MotorBrake MotorGroup::get_brake_mode(const std::uint8_t index) const {
+  AT_INDEX(MotorBrake(simMotor(port).brakeMode))
+}
+
+std::vector<MotorBrake> MotorGroup::get_brake_mode_all(void) const {
+  FOR_EACH_PORT(MotorBrake, MotorBrake(simMotor(port).brakeMode))
+}
+
+std::int32_t MotorGroup::get_current_limit(const std::uint8_t index) const {
+  AT_INDEX(simMotor(port).currentLimit)
+}
+
+std::vector<std::int32_t> MotorGroup::get_current_limit_all(void) const {
+  FOR_EACH_PORT(std::int32_t, simMotor(port).currentLimit)
+}
+
+MotorUnits MotorGroup::get_encoder_units(const std::uint8_t index) const {
+  AT_INDEX(MotorUnits(simMotor(port).encoderUnits))
+}
+
+std::vector<MotorUnits> MotorGroup::get_encoder_units_all(void) const {
+  FOR_EACH_PORT(MotorUnits, MotorUnits(simMotor(port).encoderUnits))
+}
+
+MotorGears MotorGroup::get_gearing(const std::uint8_t index) const {
+  AT_INDEX(MotorGears(simMotor(port).gearing))
+}
+
+std::vector<MotorGears> MotorGroup::get_gearing_all(void) const {
+  FOR_EACH_PORT(MotorGears, MotorGears(simMotor(port).gearing))
+}
+
+std::vector<std::int8_t> MotorGroup::get_port_all(void) const {
+  return _ports;
+}
+
+std::int32_t MotorGroup::get_voltage_limit(const std::uint8_t index) const {
+  AT_INDEX(simMotor(port).voltageLimit)
+}
+
+std::vector<std::int32_t> MotorGroup::get_voltage_limit_all(void) const {
+  FOR_EACH_PORT(std::int32_t, simMotor(port).voltageLimit)
+}
+
+std::int32_t MotorGroup::is_reversed(const std::uint8_t index) const {
+  AT_INDEX(std::int32_t(port < 0))
+}
+
+std::vector<std::int32_t> MotorGroup::is_reversed_all(void) const {
+  FOR_EACH_PORT(std::int32_t, std::int32_t(port < 0))
+}
+
+#undef FOR_EACH_PORT
+#undef AT_INDEX
+
+std::int32_t MotorGroup::set_brake_mode(const MotorBrake mode,
+                                        const std::uint8_t index) const {
+  if (index >= _ports.size()) return PROS_ERR;
+  simMotor(_ports[index]).brakeMode = std::int32_t(mode);
+  return 1;
+}
+
+std::int32_t MotorGroup::set_brake_mode(const pros::motor_brake_mode_e_t mode,
+                                        const std::uint8_t index) const {
+  return set_brake_mode(MotorBrake(mode), index);
+}
+
+std::int32_t MotorGroup::set_brake_mode_all(const MotorBrake mode) const {
+  for (std::int8_t port : _ports) simMotor(port).brakeMode = std::int32_t(mode);
+  return 1;
+}
+
+std::int32_t
+MotorGroup::set_brake_mode_all(const pros::motor_brake_mode_e_t mode) const {
+  return set_brake_mode_all(MotorBrake(mode));
+}
+
+std::int32_t MotorGroup::set_current_limit(const std::int32_t limit,
+                                           const std::uint8_t index) const {
+  if (index >= _ports.size()) return PROS_ERR;
+  simMotor(_ports[index]).currentLimit = limit;
+  return 1;
+}
+
+std::int32_t MotorGroup::set_current_limit_all(const std::int32_t limit) const {
+  for (std::int8_t port : _ports) simMotor(port).currentLimit = limit;
+  return 1;
+}
+
+std::int32_t MotorGroup::set_encoder_units(const MotorUnits units,
+                                           const std::uint8_t index) const {
+  if (index >= _ports.size()) return PROS_ERR;
+  simMotor(_ports[index]).encoderUnits = std::int32_t(units);
+  return 1;
+}
+
+std::int32_t
+MotorGroup::set_encoder_units(const pros::motor_encoder_units_e_t units,
+                              const std::uint8_t index) const {
+  return set_encoder_units(MotorUnits(units), index);
+}
+
+std::int32_t MotorGroup::set_encoder_units_all(const MotorUnits units) const {
+  for (std::int8_t port : _ports)
+    simMotor(port).encoderUnits = std::int32_t(units);
+  return 1;
+}
+
+std::int32_t
+MotorGroup::set_encoder_units_all(
+    const pros::motor_encoder_units_e_t units) const {
+  return set_encoder_units_all(MotorUnits(units));
+}
+
+std::int32_t
+MotorGroup::set_gearing(std::vector<pros::motor_gearset_e_t> gearsets) const {
+  for (size_t i = 0; i < gearsets.size() && i < _ports.size(); ++i)
+    set_gearing(MotorGears(gearsets[i]), i);
+  return 1;
+}
+
+std::int32_t MotorGroup::set_gearing(const pros::motor_gearset_e_t gearset,
+                                     const std::uint8_t index) const {
+  return set_gearing(MotorGears(gearset), index);
+}
+
+std::int32_t MotorGroup::set_gearing(std::vector<MotorGears> gearsets) const {
+  for (size_t i = 0; i < gearsets.size() && i < _ports.size(); ++i)
+    set_gearing(gearsets[i], i);
+  return 1;
+}
+
+std::int32_t MotorGroup::set_gearing(const MotorGears gearset,
+                                     const std::uint8_t index) const {
+  if (index >= _ports.size() || gearset == MotorGears::invalid) return PROS_ERR;
+  sim::Motor& motor = simMotor(_ports[index]);
+  motor.gearing = std::int32_t(gearset);
+  motor.freeSpeed = FREE_SPEED[motor.gearing];
+  return 1;
+}
+
+std::int32_t MotorGroup::set_gearing_all(const MotorGears gearset) const {
+  for (size_t i = 0; i < _ports.size(); ++i) set_gearing(gearset, i);
+  return 1;
+}
+
+std::int32_t
+MotorGroup::set_gearing_all(const pros::motor_gearset_e_t gearset) const {
+  return set_gearing_all(MotorGears(gearset));
+}
+
+std::int32_t MotorGroup::set_reversed(const bool reverse,
+                                      const std::uint8_t index) {
+  if (index >= _ports.size()) return PROS_ERR;
+  _ports[index] = reverse ? -std::abs(_ports[index]) : std::abs(_ports[index]);
+  return 1;
+}
+
+std::int32_t MotorGroup::set_reversed_all(const bool reverse) {
+  for (size_t i = 0; i < _ports.size(); ++i) set_reversed(reverse, i);
+  return 1;
+}
+
+std::int32_t MotorGroup::set_voltage_limit(const std::int32_t limit,
+                                           const std::uint8_t index) const {
+  if (index >= _ports.size()) return PROS_ERR;
+  simMotor(_ports[index]).voltageLimit = limit;
+  return 1;
+}
+
+std::int32_t MotorGroup::set_voltage_limit_all(const std::int32_t limit) const {
+  for (std::int8_t port : _ports) simMotor(port).voltageLimit = limit;
+  return 1;
+}
+
+std::int32_t MotorGroup::set_zero_position(const double position,
+                                           const std::uint8_t index) const {
+  if (index >= _ports.size()) return PROS_ERR;
+  sim::Motor& motor = simMotor(_ports[index]);
+  motor.position -= direction(_ports[index]) * fromUnits(motor, position);
+  return 1;
+}
+
+std::int32_t MotorGroup::set_zero_position_all(const double position) const {
+  for (size_t i = 0; i < _ports.size(); ++i) set_zero_position(position, i);
+  return 1;
+}
+
+std::int32_t MotorGroup::tare_position(const std::uint8_t index) const {
+  if (index >= _ports.size()) return PROS_ERR;
+  simMotor(_ports[index]).position = 0;
+  return 1;
+}
+
+std::int32_t MotorGroup::tare_position_all(void) const {
+  for (std::int8_t port : _ports) simMotor(port).position = 0;
+  return 1;
+}
+
+std::int8_t MotorGroup::size(void) const { return _ports.size(); }
+
+std::int8_t MotorGroup::get_port(const std::uint8_t index) const {
+  if (index >= _ports.size()) return PROS_ERR_BYTE;
+  return _ports[index];
+}
+
+void MotorGroup::operator+=(AbstractMotor& other) { append(other); }
+
+void MotorGroup::append(AbstractMotor& other) {
+  for (std::int8_t port : other.get_port_all()) _ports.push_back(port);
+}
+
+void MotorGroup::erase_port(std::int8_t port) {
+  std::erase_if(_ports, [port](std::int8_t other) {
+    return std::abs(other) == std::abs(port);
+  });
+}
+} // namespace pros::v5
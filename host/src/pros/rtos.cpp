@@ -0,0 +1,187 @@
+#include "pros/rtos.hpp"
+#include "sim/kernel.h"
+
+using sim::Kernel;
+
+namespace {
+Kernel::Task* toTask(pros::task_t task) {
+  if (task == CURRENT_TASK) return Kernel::get().current();
+  return static_cast<Kernel::Task*>(task);
+}
+} // namespace
+
+namespace pros::c {
+uint32_t millis(void) { return Kernel::get().micros() / 1000; }
+
+uint64_t micros(void) { return Kernel::get().micros(); }
+
+task_t task_create(task_fn_t function, void* const parameters, uint32_t prio,
+                   const uint16_t, const char* const name) {
+  return Kernel::get().create([function, parameters] { function(parameters); },
+                              prio, name);
+}
+
+void task_delete(task_t task) { Kernel::get().remove(toTask(task)); }
+
+void task_delay(const uint32_t milliseconds) {
+  Kernel::get().sleepUntil(Kernel::get().micros() +
+                           uint64_t(milliseconds) * 1000);
+}
+
+void delay(const uint32_t milliseconds) { task_delay(milliseconds); }
+
+void task_delay_until(uint32_t* const prev_time, const uint32_t delta) {
+  // FreeRTOS semantics: the wake time is relative to the previous wake time,
+  // not to now, so a late task catches up instead of drifting
+  *prev_time += delta;
+  Kernel::get().sleepUntil(uint64_t(*prev_time) * 1000);
+}
+
+uint32_t task_get_priority(task_t task) { return toTask(task)->priority; }
+
+void task_set_priority(task_t task, uint32_t prio) {
+  Kernel::get().setPriority(toTask(task), prio);
+}
+
+task_state_e_t task_get_state(task_t task) {
+  switch (toTask(task)->state) {
+    case Kernel::State::RUNNING: return E_TASK_STATE_RUNNING;
+    case Kernel::State::READY: return E_TASK_STATE_READY;
+    case Kernel::State::BLOCKED: return E_TASK_STATE_BLOCKED;
+    case Kernel::State::SUSPENDED: return E_TASK_STATE_SUSPENDED;
+    case Kernel::State::DELETED: return E_TASK_STATE_DELETED;
+  }
+  return E_TASK_STATE_INVALID;
+}
+
+void task_suspend(task_t task) { Kernel::get().suspend(toTask(task)); }
+
+void task_resume(task_t task) { Kernel::get().resume(toTask(task)); }
+
+uint32_t task_get_count(void) { return Kernel::get().count(); }
+
+char* task_get_name(task_t task) { return toTask(task)->name.data(); }
+
+task_t task_get_by_name(const char* name) { return Kernel::get().find(name); }
+
+task_t task_get_current() { return Kernel::get().current(); }
+
+uint32_t task_notify(task_t task) {
+  return Kernel::get().notify(toTask(task), 0, E_NOTIFY_ACTION_INCR, nullptr);
+}
+
+void task_join(task_t task) { Kernel::get().join(toTask(task)); }
+
+uint32_t task_notify_ext(task_t task, uint32_t value,
+                         notify_action_e_t action, uint32_t* prev_value) {
+  return Kernel::get().notify(toTask(task), value, action, prev_value);
+}
+
+uint32_t task_notify_take(bool clear_on_exit, uint32_t timeout) {
+  return Kernel::get().notifyTake(clear_on_exit, timeout);
+}
+
+bool task_notify_clear(task_t task) {
+  uint32_t prev = 0;
+  Kernel::get().notify(toTask(task), 0, E_NOTIFY_ACTION_OWRITE, &prev);
+  return prev != 0;
+}
+
+mutex_t mutex_create(void) { return new Kernel::Mutex(); }
+
+bool mutex_take(mutex_t mutex, uint32_t timeout) {
+  return Kernel::get().take(static_cast<Kernel::Mutex*>(mutex), timeout);
+}
+
+bool mutex_give(mutex_t mutex) {
+  return Kernel::get().give(static_cast<Kernel::Mutex*>(mutex));
+}
+
+void mutex_delete(mutex_t mutex) { delete static_cast<Kernel::Mutex*>(mutex); }
+} // namespace pros::c
+
+namespace pros::rtos {
+Task::Task(task_fn_t function, void* parameters, std::uint32_t prio,
+           std::uint16_t stack_depth, const char* name)
+  : task(c::task_create(function, parameters, prio, stack_depth, name)) {}
+
+Task::Task(task_fn_t function, void* parameters, const char* name)
+  : Task(function, parameters, TASK_PRIORITY_DEFAULT,
+         TASK_STACK_DEPTH_DEFAULT, name) {}
+
+Task::Task(task_t task) : task(task) {}
+
+Task Task::current() { return Task(c::task_get_current()); }
+
+Task& Task::operator=(task_t in) {
+  task = in;
+  return *this;
+}
+
+void Task::remove() { c::task_delete(task); }
+
+std::uint32_t Task::get_priority() { return c::task_get_priority(task); }
+
+void Task::set_priority(std::uint32_t prio) {
+  c::task_set_priority(task, prio);
+}
+
+std::uint32_t Task::get_state() { return c::task_get_state(task); }
+
+void Task::suspend() { c::task_suspend(task); }
+
+void Task::resume() { c::task_resume(task); }
+
+const char* Task::get_name() { return c::task_get_name(task); }
+
+std::uint32_t Task::notify() { return c::task_notify(task); }
+
+void Task::join() { c::task_join(task); }
+
+std::uint32_t Task::notify_ext(std::uint32_t value, notify_action_e_t action,
+                               std::uint32_t* prev_value) {
+  return c::task_notify_ext(task, value, action, prev_value);
+}
+
+std::uint32_t Task::notify_take(bool clear_on_exit, std::uint32_t timeout) {
+  return c::task_notify_take(clear_on_exit, timeout);
+}
+
+bool Task::notify_clear() { return c::task_notify_clear(task); }
+
+void Task::delay(const std::uint32_t milliseconds) {
+  c::task_delay(milliseconds);
+}
+
+void Task::delay_until(std::uint32_t* const prev_time,
+                       const std::uint32_t delta) {
+  c::task_delay_until(prev_time, delta);
+}
+
+std::uint32_t Task::get_count() { return c::task_get_count(); }
+
+Clock::time_point Clock::now() {
+  return time_point {duration {c::millis()}};
+}
+
+Mutex::Mutex() : mutex(c::mutex_create(), c::mutex_delete) {}
+
+bool Mutex::take() { return c::mutex_take(mutex.get(), TIMEOUT_MAX); }
+
+bool Mutex::take(std::uint32_t timeout) {
+  return c::mutex_take(mutex.get(), timeout);
+}
+
+bool Mutex::give() { return c::mutex_give(mutex.get()); }
+
+void Mutex::lock() {
+  if (!take(TIMEOUT_MAX))
+    throw std::system_error(errno, std::system_category());
+}
+
+void Mutex::unlock() {
+  if (!give()) throw std::system_error(errno, std::system_category());
+}
+
+bool Mutex::try_lock() { return take(0); }
+} // namespace pros::rtos
@@ -0,0 +1,219 @@
+#include "pros/device.hpp"
+#include "pros/imu.hpp"
+#include "pros/optical.hpp"
+#include "pros/rotation.hpp"
+#include "sim/devices.h"
+#include <cmath>
+#include <cstdlib>
+
+namespace pros::v5 {
+Device::Device(const std::uint8_t port)
+  : _port(port), _deviceType(DeviceType::undefined) {}
+
+std::uint8_t Device::get_port(void) const { return _port; }
+
+bool Device::is_installed() { return true; }
+
+pros::DeviceType Device::get_plugged_type() const { return _deviceType; }
+
+Rotation::Rotation(const std::int8_t port)
+  : Device(std::abs(port), DeviceType::rotation) {
+  if (port < 0) sim::rotation(_port).reversed = true;
+}
+
+std::int32_t Rotation::reset() { return reset_position(); }
+
+std::int32_t Rotation::set_data_rate(std::uint32_t rate) const {
+  // the sensor rounds down to a multiple of 5ms, with a minimum of 5ms
+  sim::rotation(_port).dataRate = std::max<std::uint32_t>(rate / 5 * 5, 5);
+  return 1;
+}
+
+std::int32_t Rotation::set_position(std::uint32_t position) const {
+  sim::Rotation& rotation = sim::rotation(_port);
+  rotation.position = rotation.reversed ? -double(position) : position;
+  return 1;
+}
+
+std::int32_t Rotation::reset_position(void) const { return set_position(0); }
+
+std::int32_t Rotation::get_position() const {
+  const sim::Rotation& rotation = sim::rotation(_port);
+  return rotation.reversed ? -rotation.position : rotation.position;
+}
+
+std::int32_t Rotation::get_velocity() const {
+  const sim::Rotation& rotation = sim::rotation(_port);
+  return rotation.reversed ? -rotation.velocity : rotation.velocity;
+}
+
+std::int32_t Rotation::get_angle() const {
+  const std::int32_t angle = std::fmod(get_position(), 36000);
+  return angle < 0 ? angle + 36000 : angle;
+}
+
+std::int32_t Rotation::set_reversed(bool value) const {
+  sim::rotation(_port).reversed = value;
+  return 1;
+}
+
+std::int32_t Rotation::reverse() const {
+  return set_reversed(!sim::rotation(_port).reversed);
+}
+
+std::int32_t Rotation::get_reversed() const {
+  return sim::rotation(_port).reversed;
+}
+
+Optical::Optical(const std::uint8_t port)
+  : Device(port, DeviceType::optical) {}
+
+double Optical::get_hue() { return sim::optical(_port).hue; }
+
+double Optical::get_saturation() { return sim::optical(_port).saturation; }
+
+double Optical::get_brightness() { return sim::optical(_port).brightness; }
+
+std::int32_t Optical::get_proximity() { return sim::optical(_port).proximity; }
+
+std::int32_t Optical::set_led_pwm(uint8_t value) {
+  sim::optical(_port).ledPwm = value;
+  return 1;
+}
+
+std::int32_t Optical::get_led_pwm() { return sim::optical(_port).ledPwm; }
+
+pros::c::optical_rgb_s_t Optical::get_rgb() {
+  const sim::Optical& optical = sim::optical(_port);
+  return {.red = optical.red,
+          .green = optical.green,
+          .blue = optical.blue,
+          .brightness = optical.brightness};
+}
+
+pros::c::optical_raw_s_t Optical::get_raw() {
+  const sim::Optical& optical = sim::optical(_port);
+  return {.clear = std::uint32_t(optical.brightness * 65535),
+          .red = std::uint32_t(optical.red),
+          .green = std::uint32_t(optical.green),
+          .blue = std::uint32_t(optical.blue)};
+}
+
+pros::c::optical_direction_e_t Optical::get_gesture() {
+  return pros::c::NO_GESTURE;
+}
+
+pros::c::optical_gesture_s_t Optical::get_gesture_raw() { return {}; }
+
+std::int32_t Optical::enable_gesture() { return 1; }
+
+std::int32_t Optical::disable_gesture() { return 1; }
+
+namespace {
+double wrap(double degrees) {
+  const double wrapped = std::fmod(degrees, 360);
+  return wrapped < 0 ? wrapped + 360 : wrapped;
+}
+} // namespace
+
+std::int32_t Imu::reset(bool blocking) const {
+  sim::Imu& imu = sim::imu(_port);
+  imu.calibratedAt = pros::c::millis() + 2000;
+  imu.headingOffset = -imu.rotation;
+  imu.rotationOffset = -imu.rotation;
+  if (blocking) pros::c::delay(2000);
+  return 1;
+}
+
+std::int32_t Imu::set_data_rate(std::uint32_t rate) const {
+  sim::imu(_port).dataRate = std::max<std::uint32_t>(rate / 5 * 5, 5);
+  return 1;
+}
+
+double Imu::get_rotation() const {
+  const sim::Imu& imu = sim::imu(_port);
+  return imu.rotation + imu.rotationOffset;
+}
+
+double Imu::get_heading() const {
+  const sim::Imu& imu = sim::imu(_port);
+  return wrap(imu.rotation + imu.headingOffset);
+}
+
+pros::quaternion_s_t Imu::get_quaternion() const {
+  const double yaw = -get_yaw() * M_PI / 180;
+  return {.x = 0, .y = 0, .z = std::sin(yaw / 2), .w = std::cos(yaw / 2)};
+}
+
+pros::euler_s_t Imu::get_euler() const {
+  return {.pitch = 0, .roll = 0, .yaw = get_yaw()};
+}
+
+double Imu::get_pitch() const { return 0; }
+
+double Imu::get_roll() const { return 0; }
+
+double Imu::get_yaw() const {
+  const double heading = get_heading();
+  return heading > 180 ? heading - 360 : heading;
+}
+
+pros::imu_gyro_s_t Imu::get_gyro_rate() const {
+  return {.x = 0, .y = 0, .z = sim::imu(_port).gyroZ};
+}
+
+std::int32_t Imu::tare_rotation() const { return set_rotation(0); }
+
+std::int32_t Imu::tare_heading() const { return set_heading(0); }
+
+std::int32_t Imu::tare_pitch() const { return 1; }
+
+std::int32_t Imu::tare_yaw() const { return set_heading(0); }
+
+std::int32_t Imu::tare_roll() const { return 1; }
+
+std::int32_t Imu::tare() const {
+  tare_heading();
+  return tare_rotation();
+}
+
+std::int32_t Imu::tare_euler() const { return tare_heading(); }
+
+std::int32_t Imu::set_heading(const double target) const {
+  sim::Imu& imu = sim::imu(_port);
+  imu.headingOffset = target - imu.rotation;
+  return 1;
+}
+
+std::int32_t Imu::set_rotation(const double target) const {
+  sim::Imu& imu = sim::imu(_port);
+  imu.rotationOffset = target - imu.rotation;
+  return 1;
+}
+
+std::int32_t Imu::set_yaw(const double target) const {
+  return set_heading(wrap(target));
+}
+
+std::int32_t Imu::set_pitch(const double) const { return 1; }
+
+std::int32_t Imu::set_roll(const double) const { return 1; }
+
+std::int32_t Imu::set_euler(const pros::euler_s_t target) const {
+  return set_yaw(target.yaw);
+}
+
+pros::imu_accel_s_t Imu::get_accel() const { return {.x = 0, .y = 0, .z = 1}; }
+
+pros::ImuStatus Imu::get_status() const {
+  return is_calibrating() ? ImuStatus::calibrating : ImuStatus::ready;
+}
+
+bool Imu::is_calibrating() const {
+  return pros::c::millis() < sim::imu(_port).calibratedAt;
+}
+
+imu_orientation_e_t Imu::get_physical_orientation() const {
+  return pros::E_IMU_Z_UP;
+}
+} // namespace pros::v5
@@ -0,0 +1,95 @@
+#include "sim/devices.h"
+#include "sim/kernel.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace sim {
+/** physics is never integrated in steps larger than this, in seconds */
+constexpr double MAX_STEP = 0.001;
+
+namespace {
+struct World {
+    std::array<Motor, 22> motors;
+    std::array<Rotation, 22> rotations;
+    std::array<Imu, 22> imus;
+    std::array<Optical, 22> opticals;
+    std::map<std::pair<uint8_t, uint8_t>, AdiPort> adiPorts;
+    std::map<std::pair<uint8_t, uint8_t>, Led> leds;
+    Controller controller;
+    Lcd lcd;
+    std::vector<std::function<void(double dt)>> plants;
+
+    World() {
+      Kernel::get().addStepper([this](double dt) { step(dt); });
+    }
+
+    void stepMotor(Motor& motor, double dt) {
+      // the motor's built in controllers are modeled as ideal voltage sources
+      switch (motor.mode) {
+        case Motor::Mode::VOLTAGE: break;
+        case Motor::Mode::VELOCITY:
+          motor.voltage = motor.targetVelocity / motor.freeSpeed * 12000;
+          break;
+        case Motor::Mode::POSITION: {
+          const double error = motor.targetPosition - motor.position;
+          const double velocity =
+              std::clamp(error * 2, -std::abs(motor.targetVelocity),
+                         std::abs(motor.targetVelocity));
+          motor.voltage = velocity / motor.freeSpeed * 12000;
+          break;
+        }
+      }
+      motor.voltage = std::clamp(motor.voltage, -12000, 12000);
+      const double applied = motor.voltage + motor.externalVoltage;
+      double target = motor.freeSpeed * applied / 12000.0;
+      double tau = motor.timeConstant;
+      if (motor.braking) {
+        // hold and brake short the windings, which stops the motor quickly
+        target = 0;
+        tau = motor.brakeMode == 0 ? tau * 4 : tau / 4;
+      }
+      motor.velocity += (target - motor.velocity) * (1 - std::exp(-dt / tau));
+      motor.position += motor.velocity / 60.0 * 360.0 * dt;
+    }
+
+    void step(double dt) {
+      while (dt > 0) {
+        const double h = std::min(dt, MAX_STEP);
+        for (Motor& motor : motors) stepMotor(motor, h);
+        for (auto& plant : plants) plant(h);
+        dt -= h;
+      }
+    }
+};
+
+World& world() {
+  static World* instance = new World();
+  return *instance;
+}
+} // namespace
+
+Motor& motor(uint8_t port) { return world().motors.at(port); }
+
+Rotation& rotation(uint8_t port) { return world().rotations.at(port); }
+
+Imu& imu(uint8_t port) { return world().imus.at(port); }
+
+Optical& optical(uint8_t port) { return world().opticals.at(port); }
+
+AdiPort& adi(uint8_t smartPort, uint8_t adiPort) {
+  return world().adiPorts[{smartPort, adiPort}];
+}
+
+Led& led(uint8_t smartPort, uint8_t adiPort) {
+  return world().leds[{smartPort, adiPort}];
+}
+
+Controller& controller() { return world().controller; }
+
+Lcd& lcd() { return world().lcd; }
+
+void addPlant(std::function<void(double dt)> plant) {
+  world().plants.push_back(std::move(plant));
+}
+} // namespace sim
@@ -0,0 +1,304 @@
+#include "sim/kernel.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace sim {
+
+Kernel& Kernel::get() {
+  // leaked on purpose, tasks may still be parked on it when main returns
+  static Kernel* instance = new Kernel();
+  return *instance;
+}
+
+Kernel::Kernel() {
+  // the thread that constructs the kernel (the one running static init and
+  // main) is treated as a task too
+  m_tasks.push_back(Task {.name = "main", .priority = 8});
+  m_running = &m_tasks.back();
+  m_running->state = State::RUNNING;
+  m_sliceStart = std::chrono::steady_clock::now();
+}
+
+Kernel::Task* Kernel::create(std::function<void()> function,
+                             uint32_t priority, const char* name) {
+  std::unique_lock lock(m_mutex);
+  m_tasks.push_back(Task {.name = name == nullptr ? "" : name,
+                          .priority = priority,
+                          .function = std::move(function)});
+  Task* task = &m_tasks.back();
+  m_ready.push_back(task);
+
+  std::thread([this, task] {
+    std::unique_lock lock(m_mutex);
+    waitForCpu(lock, task);
+    lock.unlock();
+    task->function();
+    lock.lock();
+    chargeSlice();
+    task->state = State::DELETED;
+    for (Task& other : m_tasks)
+      if (other.state == State::BLOCKED && other.waitingOn == task)
+        unblock(&other);
+    dispatch();
+  }).detach();
+  return task;
+}
+
+Kernel::Task* Kernel::current() {
+  std::unique_lock lock(m_mutex);
+  return m_running;
+}
+
+uint64_t Kernel::micros() {
+  std::unique_lock lock(m_mutex);
+  const auto slice = std::chrono::steady_clock::now() - m_sliceStart;
+  return m_now +
+         uint64_t(
+             std::chrono::duration<double, std::micro>(slice).count() *
+             m_cpuScale);
+}
+
+void Kernel::sleepUntil(uint64_t wake) {
+  std::unique_lock lock(m_mutex);
+  block(lock, wake, nullptr);
+}
+
+void Kernel::yield() {
+  std::unique_lock lock(m_mutex);
+  chargeSlice();
+  Task* self = m_running;
+  self->state = State::READY;
+  m_ready.push_back(self);
+  dispatch();
+  waitForCpu(lock, self);
+}
+
+bool Kernel::take(Mutex* mutex, uint32_t timeoutMs) {
+  std::unique_lock lock(m_mutex);
+  Task* self = m_running;
+  if (mutex->owner == nullptr) {
+    mutex->owner = self;
+    return true;
+  }
+  if (timeoutMs == 0) return false;
+
+  mutex->waiters.push_back(self);
+  block(lock,
+        timeoutMs == UINT32_MAX ? NEVER : m_now + uint64_t(timeoutMs) * 1000,
+        mutex);
+  if (mutex->owner == self) return true;
+  // timed out
+  std::erase(mutex->waiters, self);
+  return false;
+}
+
+bool Kernel::give(Mutex* mutex) {
+  std::unique_lock lock(m_mutex);
+  if (mutex->owner != m_running) return false;
+  mutex->owner = nullptr;
+  while (!mutex->waiters.empty()) {
+    Task* next = mutex->waiters.front();
+    mutex->waiters.pop_front();
+    if (next->state != State::BLOCKED) continue;
+    // hand ownership straight to the longest waiter
+    mutex->owner = next;
+    unblock(next);
+    break;
+  }
+  return true;
+}
+
+uint32_t Kernel::notify(Task* task, uint32_t value, int action,
+                        uint32_t* prevValue) {
+  std::unique_lock lock(m_mutex);
+  if (prevValue != nullptr) *prevValue = task->notifyValue;
+  switch (action) {
+    case 1: task->notifyValue |= value; break;
+    case 2: ++task->notifyValue; break;
+    case 3: task->notifyValue = value; break;
+    case 4:
+      if (task->notifyValue != 0) return 0;
+      task->notifyValue = value;
+      break;
+    default: break;
+  }
+  if (task->state == State::BLOCKED && task->waitingOn == &task->notifyValue)
+    unblock(task);
+  return 1;
+}
+
+uint32_t Kernel::notifyTake(bool clearOnExit, uint32_t timeoutMs) {
+  std::unique_lock lock(m_mutex);
+  Task* self = m_running;
+  if (self->notifyValue == 0 && timeoutMs != 0)
+    block(lock,
+          timeoutMs == UINT32_MAX ? NEVER
+                                  : m_now + uint64_t(timeoutMs) * 1000,
+          &self->notifyValue);
+  const uint32_t value = self->notifyValue;
+  if (value != 0) self->notifyValue = clearOnExit ? 0 : value - 1;
+  return value;
+}
+
+void Kernel::join(Task* task) {
+  std::unique_lock lock(m_mutex);
+  while (task->state != State::DELETED) block(lock, NEVER, task);
+}
+
+void Kernel::suspend(Task* task) {
+  std::unique_lock lock(m_mutex);
+  if (task == m_running) {
+    chargeSlice();
+    task->state = State::SUSPENDED;
+    dispatch();
+    waitForCpu(lock, task);
+    return;
+  }
+  std::erase(m_ready, task);
+  task->state = State::SUSPENDED;
+}
+
+void Kernel::resume(Task* task) {
+  std::unique_lock lock(m_mutex);
+  if (task->state != State::SUSPENDED) return;
+  task->state = State::READY;
+  m_ready.push_back(task);
+}
+
+void Kernel::remove(Task* task) {
+  std::unique_lock lock(m_mutex);
+  if (task->state == State::DELETED) return;
+  std::erase(m_ready, task);
+  task->state = State::DELETED;
+  for (Task& other : m_tasks)
+    if (other.state == State::BLOCKED && other.waitingOn == task)
+      unblock(&other);
+  if (task != m_running) return;
+  chargeSlice();
+  dispatch();
+  // this thread will never be handed the cpu again
+  m_cv.wait(lock, [] { return false; });
+}
+
+void Kernel::setPriority(Task* task, uint32_t priority) {
+  std::unique_lock lock(m_mutex);
+  task->priority = priority;
+}
+
+Kernel::Task* Kernel::find(const char* name) {
+  std::unique_lock lock(m_mutex);
+  for (Task& task : m_tasks)
+    if (task.state != State::DELETED && task.name == name) return &task;
+  return nullptr;
+}
+
+uint32_t Kernel::count() {
+  std::unique_lock lock(m_mutex);
+  return std::count_if(m_tasks.begin(), m_tasks.end(), [](const Task& task) {
+    return task.state != State::DELETED;
+  });
+}
+
+std::vector<Kernel::Task> Kernel::tasks() {
+  std::unique_lock lock(m_mutex);
+  chargeSlice();
+  std::vector<Task> copy;
+  for (const Task& task : m_tasks) {
+    copy.push_back(task);
+    copy.back().function = nullptr;
+  }
+  return copy;
+}
+
+void Kernel::setCpuScale(double scale) {
+  std::unique_lock lock(m_mutex);
+  chargeSlice();
+  m_cpuScale = scale;
+}
+
+void Kernel::addStepper(std::function<void(double dt)> stepper) {
+  std::unique_lock lock(m_mutex);
+  m_steppers.push_back(std::move(stepper));
+}
+
+void Kernel::exit(int code) {
+  std::fflush(stdout);
+  std::fflush(stderr);
+  std::_Exit(code);
+}
+
+void Kernel::dispatch() {
+  while (true) {
+    step();
+    // wake every task whose timeout has passed, in creation order
+    for (Task& task : m_tasks) {
+      if (task.state != State::BLOCKED || task.wakeTime > m_now) continue;
+      task.timedOut = true;
+      unblock(&task);
+    }
+    if (!m_ready.empty()) break;
+
+    uint64_t next = NEVER;
+    for (const Task& task : m_tasks)
+      if (task.state == State::BLOCKED) next = std::min(next, task.wakeTime);
+    if (next == NEVER) {
+      std::fprintf(stderr, "sim: every task is blocked forever at %llu us\n",
+                   (unsigned long long)m_now);
+      exit(1);
+    }
+    m_now = next;
+  }
+
+  // highest priority first, round robin within a priority
+  auto next = std::max_element(m_ready.begin(), m_ready.end(),
+                               [](const Task* a, const Task* b) {
+                                 return a->priority < b->priority;
+                               });
+  m_running = *next;
+  m_ready.erase(next);
+  m_running->state = State::RUNNING;
+  m_sliceStart = std::chrono::steady_clock::now();
+  m_cv.notify_all();
+}
+
+void Kernel::waitForCpu(std::unique_lock<std::mutex>& lock, Task* task) {
+  m_cv.wait(lock, [this, task] { return m_running == task; });
+}
+
+void Kernel::block(std::unique_lock<std::mutex>& lock, uint64_t wakeTime,
+                   const void* waitingOn) {
+  chargeSlice();
+  Task* self = m_running;
+  self->state = State::BLOCKED;
+  self->wakeTime = wakeTime;
+  self->waitingOn = waitingOn;
+  self->timedOut = false;
+  dispatch();
+  waitForCpu(lock, self);
+}
+
+void Kernel::unblock(Task* task) {
+  task->state = State::READY;
+  task->waitingOn = nullptr;
+  m_ready.push_back(task);
+}
+
+void Kernel::chargeSlice() {
+  const auto now = std::chrono::steady_clock::now();
+  const uint64_t elapsed = uint64_t(
+      std::chrono::duration<double, std::micro>(now - m_sliceStart).count() *
+      m_cpuScale);
+  m_now += elapsed;
+  m_running->cpuTime += elapsed;
+  m_sliceStart = now;
+}
+
+void Kernel::step() {
+  if (m_now == m_lastStep) return;
+  const double dt = (m_now - m_lastStep) / 1e6;
+  m_lastStep = m_now;
+  for (auto& stepper : m_steppers) stepper(dt);
+}
+} // namespace sim
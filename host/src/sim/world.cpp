@@ -0,0 +1,244 @@
+#include "sim/world.h"
+#include "sim/devices.h"
+#include <algorithm>
+#include <cmath>
+
+namespace sim::world {
+namespace {
+// ports, from src/config
+constexpr uint8_t LEFT_DRIVE[] = {11, 12, 15};
+constexpr uint8_t RIGHT_DRIVE[] = {16, 17, 18};
+constexpr uint8_t INTAKE = 20;
+constexpr uint8_t LIFT = 14;
+constexpr uint8_t VERT_ROTATION = 13;
+constexpr uint8_t HORI_ROTATION = 19;
+constexpr uint8_t LIFT_ROTATION = 5;
+constexpr uint8_t IMU = 4;
+constexpr uint8_t INTAKE_OPTICAL = 6;
+
+// drivetrain, from src/config/dimensions.cpp
+constexpr double DRIVE_WHEEL_DIAMETER = 4.0;
+constexpr double TRACK_WIDTH = 27.0 / 2;
+constexpr double VERT_WHEEL_DIAMETER = 2.0;
+constexpr double VERT_WHEEL_OFFSET = 2.0;
+constexpr double HORI_WHEEL_DIAMETER = 2.0;
+constexpr double HORI_WHEEL_OFFSET = 2.0;
+
+// lift, measured off the robot
+/** lift degrees per lift motor degree */
+constexpr double LIFT_RATIO = 1.0 / 3.0;
+/** rotation sensor angle when the lift is parallel to the ground */
+constexpr double LIFT_HORIZONTAL = 320;
+/** rotation sensor angle the lift rests at on startup */
+constexpr double LIFT_REST = 275;
+/** voltage needed to hold the lift up when horizontal, in mV */
+constexpr double LIFT_GRAVITY = 1500;
+/** extra voltage needed to hold up each ring on the lift, in mV */
+constexpr double LIFT_RING_GRAVITY = 300;
+/** voltage lost to friction while the lift moves, in mV */
+constexpr double LIFT_FRICTION = 250;
+/** lift motor rpm below which friction fades out, so the lift can stop */
+constexpr double LIFT_STICTION_RPM = 2;
+/** rotation sensor angles of the lift's hard stops */
+constexpr double LIFT_MIN = 270;
+constexpr double LIFT_MAX = 358;
+/** the lift can take a ring from the intake below this angle */
+constexpr double LIFT_LOAD = 280;
+/** a ring on the lift is scored on the wall stake above this angle */
+constexpr double LIFT_SCORE = 345;
+
+// intake, measured off the robot
+/** inches of chain travel per intake motor degree */
+constexpr double INTAKE_INCHES_PER_DEGREE = 1.3 * M_PI / 360;
+/** distance from the mouth of the intake to the optical sensor */
+constexpr double OPTICAL_POSITION = 14;
+/** the optical sensor sees a ring this far either side of its center */
+constexpr double OPTICAL_RANGE = 1.5;
+/** rings leave the intake at this distance from its mouth */
+constexpr double INTAKE_LENGTH = 20;
+/** rings past this are thrown off the top when the chain stops suddenly */
+constexpr double EJECT_START = 19;
+/**
+ * deceleration of the chain that throws rings off the top, in inches/s^2.
+ * Reversing the intake at full speed does it, letting it coast doesn't
+ */
+constexpr double EJECT_DECELERATION = 250;
+
+Pose truePose;
+double liftMotorStart = 0;
+std::deque<Ring> intakeRings;
+uint32_t scored = 0;
+uint32_t liftRings = 0;
+double lastIntakePosition = 0;
+double lastIntakeSpeed = 0;
+/** seconds since init() */
+double simTime = 0;
+double totalDwell = 0;
+uint32_t ringsOut = 0;
+Sorting sorted;
+
+bool isRed(double hue) { return hue < 30 || hue > 330; }
+bool isBlue(double hue) { return hue > 180 && hue < 260; }
+
+void leaveIntake(const Ring& ring) {
+  totalDwell += simTime - ring.fedAt;
+  ++ringsOut;
+}
+
+double wheelSpeed(const uint8_t (&ports)[3], int direction) {
+  double total = 0;
+  for (uint8_t port : ports) total += motor(port).velocity;
+  const double rpm = direction * total / 3;
+  return rpm / 60 * DRIVE_WHEEL_DIAMETER * M_PI;
+}
+
+void stepDrivetrain(double dt) {
+  // the left side is reversed in src/config/motors.cpp
+  const double left = wheelSpeed(LEFT_DRIVE, -1);
+  const double right = wheelSpeed(RIGHT_DRIVE, 1);
+  const double velocity = (left + right) / 2;
+  const double omega = (left - right) / TRACK_WIDTH;
+
+  const double avgTheta = truePose.theta + omega * dt / 2;
+  truePose.x += velocity * std::sin(avgTheta) * dt;
+  truePose.y += velocity * std::cos(avgTheta) * dt;
+  truePose.theta += omega * dt;
+
+  // a tracking wheel to the right of center sees less forward travel when
+  // turning clockwise, a wheel in front of center sees travel to the left
+  const double vert = (velocity - omega * VERT_WHEEL_OFFSET) * dt;
+  const double hori = -omega * HORI_WHEEL_OFFSET * dt;
+  Rotation& vertRotation = rotation(VERT_ROTATION);
+  Rotation& horiRotation = rotation(HORI_ROTATION);
+  vertRotation.position += vert / (VERT_WHEEL_DIAMETER * M_PI) * 36000;
+  vertRotation.velocity = vert / dt / (VERT_WHEEL_DIAMETER * M_PI) * 36000;
+  horiRotation.position += hori / (HORI_WHEEL_DIAMETER * M_PI) * 36000;
+  horiRotation.velocity = hori / dt / (HORI_WHEEL_DIAMETER * M_PI) * 36000;
+
+  Imu& simImu = imu(IMU);
+  simImu.rotation = truePose.theta * 180 / M_PI;
+  simImu.gyroZ = omega * 180 / M_PI;
+}
+
+void stepLift(double) {
+  Motor& liftMotor = motor(LIFT);
+  double angle = liftAngle();
+  // the hard stops stop the motor dead
+  if (angle < LIFT_MIN || angle > LIFT_MAX) {
+    angle = std::clamp(angle, LIFT_MIN, LIFT_MAX);
+    liftMotor.position = liftMotorStart + (angle - LIFT_REST) / LIFT_RATIO;
+    liftMotor.velocity = 0;
+  }
+  if (angle > LIFT_SCORE && liftRings > 0) {
+    scored += liftRings;
+    liftRings = 0;
+  }
+  const double gravity = LIFT_GRAVITY + LIFT_RING_GRAVITY * liftRings;
+  const double friction =
+      LIFT_FRICTION *
+      std::clamp(liftMotor.velocity / LIFT_STICTION_RPM, -1.0, 1.0);
+  liftMotor.externalVoltage =
+      -gravity * std::cos((angle - LIFT_HORIZONTAL) * M_PI / 180) - friction;
+  Rotation& liftRotation = rotation(LIFT_ROTATION);
+  liftRotation.position = angle * 100;
+  liftRotation.velocity = liftMotor.velocity * 6 * LIFT_RATIO * 100;
+}
+
+void stepIntake(double dt) {
+  simTime += dt;
+  // the intake motor is reversed in src/config/motors.cpp
+  const double position = -motor(INTAKE).position;
+  const double travel = (position - lastIntakePosition) *
+                        INTAKE_INCHES_PER_DEGREE;
+  lastIntakePosition = position;
+  const double speed = dt > 0 ? travel / dt : 0;
+  const double deceleration = dt > 0 ? (lastIntakeSpeed - speed) / dt : 0;
+  lastIntakeSpeed = speed;
+
+  for (Ring& ring : intakeRings) ring.position += travel;
+  // backing a ring off the sensor hooks it onto a lowered lift
+  if (travel < 0 && liftAngle() < LIFT_LOAD) {
+    for (auto it = intakeRings.begin(); it != intakeRings.end(); ++it) {
+      if (std::abs(it->position - OPTICAL_POSITION) > OPTICAL_RANGE) continue;
+      leaveIntake(*it);
+      intakeRings.erase(it);
+      ++liftRings;
+      break;
+    }
+  }
+  // stopping suddenly throws rings at the top off the end of the chain
+  while (deceleration > EJECT_DECELERATION && speed > 0 &&
+         !intakeRings.empty() &&
+         intakeRings.back().position > EJECT_START) {
+    const Ring& ring = intakeRings.back();
+    if (isRed(ring.hue)) ++sorted.redEjected;
+    if (isBlue(ring.hue)) ++sorted.blueEjected;
+    leaveIntake(ring);
+    intakeRings.pop_back();
+  }
+  // rings pushed out the front are lost, rings out the top are scored
+  while (!intakeRings.empty() && intakeRings.front().position < 0) {
+    leaveIntake(intakeRings.front());
+    intakeRings.pop_front();
+    ++sorted.lost;
+  }
+  while (!intakeRings.empty() && intakeRings.back().position > INTAKE_LENGTH) {
+    const Ring& ring = intakeRings.back();
+    if (isRed(ring.hue)) ++sorted.redScored;
+    if (isBlue(ring.hue)) ++sorted.blueScored;
+    leaveIntake(ring);
+    intakeRings.pop_back();
+    ++scored;
+  }
+
+  Optical& optical = sim::optical(INTAKE_OPTICAL);
+  optical.proximity = 20;
+  optical.hue = 40;
+  optical.saturation = 0.1;
+  optical.brightness = 0.1;
+  for (const Ring& ring : intakeRings) {
+    const double distance = std::abs(ring.position - OPTICAL_POSITION);
+    if (distance > OPTICAL_RANGE) continue;
+    optical.proximity = 255 - 100 * distance / OPTICAL_RANGE;
+    optical.hue = ring.hue;
+    optical.saturation = 0.8;
+    optical.brightness = 0.5;
+  }
+  // keep rgb consistent with hue, mostly for color sorting
+  const bool red = isRed(optical.hue);
+  const bool blue = isBlue(optical.hue);
+  optical.red = red ? 200 : 40;
+  optical.green = 40;
+  optical.blue = blue ? 200 : 40;
+}
+} // namespace
+
+void init() {
+  liftMotorStart = motor(LIFT).position;
+  rotation(LIFT_ROTATION).position = LIFT_REST * 100;
+  addPlant(stepDrivetrain);
+  addPlant(stepLift);
+  addPlant(stepIntake);
+}
+
+const Pose& pose() { return truePose; }
+
+double liftAngle() {
+  return LIFT_REST + (motor(LIFT).position - liftMotorStart) * LIFT_RATIO;
+}
+
+void feedRing(double hue) {
+  // rings are stored sorted from the mouth of the intake to the top
+  intakeRings.push_front(Ring {.position = 0, .hue = hue, .fedAt = simTime});
+}
+
+const std::deque<Ring>& rings() { return intakeRings; }
+
+uint32_t ringsOnLift() { return liftRings; }
+
+uint32_t ringsScored() { return scored; }
+
+double averageRingDwell() { return ringsOut ? totalDwell / ringsOut : 0; }
+
+const Sorting& sorting() { return sorted; }
+} // namespace sim::world
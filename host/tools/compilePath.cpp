@@ -0,0 +1,130 @@
+#include "path.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * Compiles a path exported from JerryIO in the LemLib format ("x, y, speed"
+ * lines, then "endData" and JerryIO's own data) into the binary format read by
+ * Path, see include/path.h.
+ *
+ * usage: compilePath <path.txt> <path.path>
+ */
+
+namespace {
+struct Point {
+    float x;
+    float y;
+    float speed;
+};
+
+/**
+ * @return signed curvature of the circle through a, b and c, positive when the
+ * path turns clockwise. 0 if the points are in a line.
+ */
+float curvature(const Point& a, const Point& b, const Point& c) {
+  const double abx = b.x - a.x, aby = b.y - a.y;
+  const double bcx = c.x - b.x, bcy = c.y - b.y;
+  const double acx = c.x - a.x, acy = c.y - a.y;
+  const double cross = abx * bcy - aby * bcx;
+  const double lengths = std::hypot(abx, aby) * std::hypot(bcx, bcy) *
+                         std::hypot(acx, acy);
+  if (lengths == 0) return 0;
+  // a counter clockwise turn has a positive cross product
+  return -2 * cross / lengths;
+}
+
+bool parse(const char* filename, std::vector<Point>& points) {
+  std::ifstream file(filename);
+  if (!file) {
+    std::fprintf(stderr, "%s: can't open\n", filename);
+    return false;
+  }
+  std::string line;
+  for (int lineNumber = 1; std::getline(file, line); ++lineNumber) {
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    if (line == "endData") return true;
+    Point point;
+    char trailing;
+    if (std::sscanf(line.c_str(), " %f , %f , %f %c", &point.x, &point.y,
+                    &point.speed, &trailing) != 3) {
+      std::fprintf(stderr, "%s:%d: expected \"x, y, speed\", got \"%s\"\n",
+                   filename, lineNumber, line.c_str());
+      return false;
+    }
+    points.push_back(point);
+  }
+  std::fprintf(stderr, "%s: missing endData\n", filename);
+  return false;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    std::fprintf(stderr, "usage: %s <path.txt> <path.path>\n", argv[0]);
+    return 2;
+  }
+
+  std::vector<Point> points;
+  if (!parse(argv[1], points)) return 1;
+  if (points.size() < 2) {
+    std::fprintf(stderr, "%s: a path needs at least 2 points\n", argv[1]);
+    return 1;
+  }
+
+  const uint32_t count = points.size();
+  const uint32_t segments = count - 1;
+  std::vector<float> arrays(5 * count + 4 * segments);
+  float* x = arrays.data();
+  float* y = x + count;
+  float* speed = y + count;
+  float* curvatures = speed + count;
+  float* distance = curvatures + count;
+  float* minX = distance + count;
+  float* minY = minX + segments;
+  float* maxX = minY + segments;
+  float* maxY = maxX + segments;
+  double totalDistance = 0;
+  for (uint32_t i = 0; i < count; ++i) {
+    x[i] = points[i].x;
+    y[i] = points[i].y;
+    speed[i] = points[i].speed;
+    // the ends use the curvature of their neighbor, and a single segment
+    // is straight
+    const uint32_t middle = std::min(std::max(i, 1u), count - 2);
+    curvatures[i] = count < 3 ? 0
+                              : curvature(points[middle - 1], points[middle],
+                                          points[middle + 1]);
+    if (i > 0) {
+      totalDistance += std::hypot(points[i].x - points[i - 1].x,
+                                  points[i].y - points[i - 1].y);
+    }
+    distance[i] = totalDistance;
+  }
+  for (uint32_t i = 0; i < segments; ++i) {
+    minX[i] = std::min(x[i], x[i + 1]);
+    minY[i] = std::min(y[i], y[i + 1]);
+    maxX[i] = std::max(x[i], x[i + 1]);
+    maxY[i] = std::max(y[i], y[i + 1]);
+  }
+
+  PathHeader header {};
+  std::memcpy(header.magic, Path::MAGIC, sizeof(header.magic));
+  header.version = Path::VERSION;
+  header.headerSize = sizeof(PathHeader);
+  header.count = count;
+
+  std::ofstream out(argv[2], std::ios::binary);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(arrays.data()),
+            arrays.size() * sizeof(float));
+  if (!out) {
+    std::fprintf(stderr, "%s: can't write\n", argv[2]);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,130 @@
+#include "armFit.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * Fits the lift's feedforward from the lift channel of a telemetry capture,
+ * after it's been through telemetryToCsv. The same fit as the lift does on the
+ * robot after Lift::characterize(), see include/armFit.h, but it can throw out
+ * samples where the lift was accelerating, so it also works on captures of
+ * ordinary driving with --all.
+ *
+ * By default only the characterization sweep is used, which is where the
+ * lift has no target.
+ *
+ * usage: fitLift <prefix.lift.csv> [--all] [--max-accel deg/s^2]
+ */
+
+namespace {
+struct Sample {
+    double time;
+    float target;
+    float angle;
+    float output;
+    float velocity;
+};
+
+bool parse(const char* filename, std::vector<Sample>& samples) {
+  std::ifstream file(filename);
+  if (!file) {
+    std::fprintf(stderr, "%s: can't open\n", filename);
+    return false;
+  }
+  std::string line;
+  if (!std::getline(file, line)) {
+    std::fprintf(stderr, "%s: empty\n", filename);
+    return false;
+  }
+  // find the columns by name, so fields can be added to the channel
+  const char* names[] = {"time", "target", "angle", "output", "velocity"};
+  int columns[5] = {-1, -1, -1, -1, -1};
+  std::stringstream header(line);
+  std::string name;
+  for (int column = 0; std::getline(header, name, ','); ++column) {
+    for (int i = 0; i < 5; ++i)
+      if (name == names[i]) columns[i] = column;
+  }
+  for (int i = 0; i < 5; ++i) {
+    if (columns[i] >= 0) continue;
+    std::fprintf(stderr, "%s: no %s column\n", filename, names[i]);
+    return false;
+  }
+
+  while (std::getline(file, line)) {
+    std::vector<double> values;
+    std::stringstream row(line);
+    std::string value;
+    while (std::getline(row, value, ','))
+      values.push_back(std::atof(value.c_str()));
+    double fields[5];
+    bool complete = true;
+    for (int i = 0; i < 5; ++i) {
+      if (columns[i] >= int(values.size())) complete = false;
+      else fields[i] = values[columns[i]];
+    }
+    if (!complete) continue;
+    samples.push_back(Sample {fields[0] / 1000, float(fields[1]),
+                              float(fields[2]), float(fields[3]),
+                              float(fields[4])});
+  }
+  return true;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  const char* filename = nullptr;
+  bool all = false;
+  double maxAccel = 60;
+  for (int i = 1; i < argc; ++i) {
+    if (!std::strcmp(argv[i], "--all")) all = true;
+    else if (!std::strcmp(argv[i], "--max-accel") && i + 1 < argc)
+      maxAccel = std::atof(argv[++i]);
+    else if (!filename) filename = argv[i];
+    else filename = nullptr, i = argc;
+  }
+  if (!filename) {
+    std::fprintf(stderr,
+                 "usage: %s <prefix.lift.csv> [--all] [--max-accel deg/s^2]\n",
+                 argv[0]);
+    return 2;
+  }
+
+  std::vector<Sample> samples;
+  if (!parse(filename, samples)) return 1;
+
+  ArmFit fit;
+  uint32_t accelerating = 0;
+  for (size_t i = 1; i + 1 < samples.size(); ++i) {
+    const Sample& sample = samples[i];
+    if (!all && !std::isnan(sample.target)) continue;
+    const Sample& before = samples[i - 1];
+    const Sample& after = samples[i + 1];
+    const double dt = after.time - before.time;
+    if (dt <= 0) continue;
+    if (std::abs(after.velocity - before.velocity) / dt > maxAccel) {
+      ++accelerating;
+      continue;
+    }
+    fit.add(sample.angle, sample.velocity, sample.output);
+  }
+
+  const ArmGains gains = fit.solve();
+  if (gains.samples == 0) {
+    std::fprintf(stderr,
+                 "%s: not enough samples of the lift moving both ways (%u "
+                 "usable, %u accelerating)\n",
+                 filename, fit.getSamples(), accelerating);
+    return 1;
+  }
+  std::printf("kG %.0f horizontal %.1f kS %.0f kV %.2f\n", gains.kG,
+              gains.horizontal, gains.kS, gains.kV);
+  std::printf("from %u samples (%u accelerating left out), rms %.0fmV\n",
+              gains.samples, accelerating, gains.rms);
+  return 0;
+}
@@ -0,0 +1,326 @@
+#include "dimensions.h"
+#include "trajectory.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * Generates a time optimal trajectory from the cubic bezier curves JerryIO
+ * writes after "endData" in its LemLib export, into the format read by
+ * Trajectory, see include/trajectory.h.
+ *
+ * The curves are reparameterized by arc length, then the velocity along them
+ * is the fastest that keeps within the drivetrain's top speed, the given
+ * acceleration, deceleration and centripetal acceleration, and the outer
+ * wheel's top speed through curves. The path's speed limit from JerryIO caps
+ * the top speed, and its max deceleration rate, in speed out of 127 per
+ * second, is the deceleration unless one is given.
+ *
+ * usage: generateTrajectory <path.txt> <path.traj>
+ *            [--acceleration in/s^2] [--deceleration in/s^2]
+ *            [--centripetal in/s^2]
+ */
+
+namespace {
+/** seconds between the trajectory's samples, the motion queue's period */
+constexpr double PERIOD = 0.01;
+/** inches between the points the velocity is planned at */
+constexpr double STEP = 0.05;
+/** samples per curve when measuring its arc length */
+constexpr int LENGTH_SAMPLES = 2000;
+
+struct Bezier {
+    double x[4];
+    double y[4];
+
+    /** @brief position, first and second derivatives at t */
+    void at(double t, double (&p)[2], double (&d1)[2], double (&d2)[2]) const {
+      const double u = 1 - t;
+      const double* c[2] = {x, y};
+      for (int i = 0; i < 2; ++i) {
+        const double* v = c[i];
+        p[i] = u * u * u * v[0] + 3 * u * u * t * v[1] + 3 * u * t * t * v[2] +
+               t * t * t * v[3];
+        d1[i] = 3 * u * u * (v[1] - v[0]) + 6 * u * t * (v[2] - v[1]) +
+                3 * t * t * (v[3] - v[2]);
+        d2[i] = 6 * u * (v[2] - 2 * v[1] + v[0]) +
+                6 * t * (v[3] - 2 * v[2] + v[1]);
+      }
+    }
+};
+
+/** @brief A point along the path, every STEP inches and at the end */
+struct Point {
+    /** inches along the path */
+    double distance;
+    double x;
+    double y;
+    /** radians clockwise from +y */
+    double theta;
+    /** 1/inches, positive when the path curves clockwise */
+    double curvature;
+    /** inches/s */
+    double velocity;
+};
+
+/** @return top speed of the drivetrain, inches/s */
+double topSpeed() {
+  return dimensions::robot::DRIVE_WHEEL_RPM / 60 * M_PI *
+         dimensions::robot::DRIVE_WHEEL_DIAMETER;
+}
+
+struct Limits {
+    /** speed limit of the path from JerryIO, 0-127 */
+    double speedLimit = 127;
+    /** inches/s^2 */
+    double acceleration = 120;
+    /** inches/s^2, 0 for the path's max deceleration rate */
+    double deceleration = 0;
+    /** inches/s^2 */
+    double centripetal = 80;
+};
+
+bool parse(const char* filename, std::vector<Bezier>& curves,
+           Limits& limits) {
+  std::ifstream file(filename);
+  if (!file) {
+    std::fprintf(stderr, "%s: can't open\n", filename);
+    return false;
+  }
+  std::string line;
+  int lineNumber = 1;
+  while (std::getline(file, line) && line.rfind("endData", 0) != 0)
+    ++lineNumber;
+  // max deceleration rate, speed limit and multiplier, then a line per curve
+  std::vector<double> header;
+  while (std::getline(file, line)) {
+    ++lineNumber;
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    if (line.rfind("#PATH", 0) == 0) break;
+    if (header.size() < 3) {
+      header.push_back(std::atof(line.c_str()));
+      continue;
+    }
+    Bezier curve;
+    char trailing;
+    if (std::sscanf(line.c_str(), " %lf , %lf , %lf , %lf , %lf , %lf , %lf , "
+                                  "%lf %c",
+                    &curve.x[0], &curve.y[0], &curve.x[1], &curve.y[1],
+                    &curve.x[2], &curve.y[2], &curve.x[3], &curve.y[3],
+                    &trailing) != 8) {
+      std::fprintf(stderr, "%s:%d: expected 8 control point coordinates, "
+                           "got \"%s\"\n",
+                   filename, lineNumber, line.c_str());
+      return false;
+    }
+    curves.push_back(curve);
+  }
+  if (header.size() < 3 || curves.empty()) {
+    std::fprintf(stderr, "%s: no bezier curves after endData\n", filename);
+    return false;
+  }
+  limits.speedLimit = header[1];
+  if (limits.deceleration == 0)
+    limits.deceleration = header[0] / 127 * topSpeed();
+  if (limits.deceleration <= 0) {
+    std::fprintf(stderr, "%s: max deceleration rate must be positive\n",
+                 filename);
+    return false;
+  }
+  return true;
+}
+
+/** @brief Samples the curves every STEP inches of arc length */
+std::vector<Point> reparameterize(const std::vector<Bezier>& curves) {
+  std::vector<Point> points;
+  double next = 0;
+  double length = 0;
+  double lastTheta = 0;
+  const auto add = [&](const Bezier& curve, double t, double distance) {
+    double p[2], d1[2], d2[2];
+    curve.at(t, p, d1, d2);
+    const double speed = std::hypot(d1[0], d1[1]);
+    Point point;
+    point.distance = distance;
+    point.x = p[0];
+    point.y = p[1];
+    // kept continuous rather than wrapped, so it can be interpolated
+    const double theta = std::atan2(d1[0], d1[1]);
+    point.theta = lastTheta + std::remainder(theta - lastTheta, 2 * M_PI);
+    lastTheta = point.theta;
+    // a counter clockwise turn has a positive cross product
+    point.curvature =
+        speed == 0 ? 0
+                   : -(d1[0] * d2[1] - d1[1] * d2[0]) / (speed * speed * speed);
+    point.velocity = 0;
+    points.push_back(point);
+  };
+  for (const Bezier& curve : curves) {
+    // arc length at each of the samples, to invert into t
+    std::vector<double> lengths(LENGTH_SAMPLES + 1);
+    double p[2], d1[2], d2[2];
+    curve.at(0, p, d1, d2);
+    double lastX = p[0], lastY = p[1];
+    for (int i = 1; i <= LENGTH_SAMPLES; ++i) {
+      curve.at(double(i) / LENGTH_SAMPLES, p, d1, d2);
+      lengths[i] = lengths[i - 1] + std::hypot(p[0] - lastX, p[1] - lastY);
+      lastX = p[0];
+      lastY = p[1];
+    }
+
+    for (; next <= length + lengths.back(); next += STEP) {
+      const double s = next - length;
+      const int i = std::upper_bound(lengths.begin(), lengths.end(), s) -
+                    lengths.begin() - 1;
+      const int j = std::min(i, LENGTH_SAMPLES - 1);
+      const double span = lengths[j + 1] - lengths[j];
+      const double t =
+          (j + (span > 0 ? (s - lengths[j]) / span : 0)) / LENGTH_SAMPLES;
+      add(curve, std::min(t, 1.0), next);
+    }
+    length += lengths.back();
+  }
+  // the end is rarely a whole number of steps along, but it's where to stop
+  if (points.back().distance < length - STEP / 100)
+    add(curves.back(), 1, length);
+  return points;
+}
+
+/**
+ * @brief Plans the fastest velocity at every point: the most each point
+ * allows on its own, then limited by accelerating from the start and
+ * decelerating into the end
+ */
+void planVelocity(std::vector<Point>& points, const Limits& limits) {
+  const double maxVelocity = topSpeed() * limits.speedLimit / 127;
+  for (Point& point : points) {
+    const double curvature = std::abs(point.curvature);
+    // the outer wheel goes faster than the center of the robot
+    double velocity = std::min(
+        maxVelocity,
+        topSpeed() / (1 + curvature * dimensions::robot::TRACK_WIDTH / 2));
+    if (curvature > 0)
+      velocity = std::min(velocity, std::sqrt(limits.centripetal / curvature));
+    point.velocity = velocity;
+  }
+  points.front().velocity = 0;
+  points.back().velocity = 0;
+  for (size_t i = 1; i < points.size(); ++i) {
+    const double step = points[i].distance - points[i - 1].distance;
+    points[i].velocity = std::min(
+        points[i].velocity,
+        std::sqrt(points[i - 1].velocity * points[i - 1].velocity +
+                  2 * limits.acceleration * step));
+  }
+  for (size_t i = points.size() - 1; i-- > 0;) {
+    const double step = points[i + 1].distance - points[i].distance;
+    points[i].velocity = std::min(
+        points[i].velocity,
+        std::sqrt(points[i + 1].velocity * points[i + 1].velocity +
+                  2 * limits.deceleration * step));
+  }
+}
+
+/** @return the planned points resampled every PERIOD seconds */
+std::vector<TrajectoryState> resample(const std::vector<Point>& points) {
+  // time at each point, from the average velocity between them
+  std::vector<double> times(points.size());
+  for (size_t i = 1; i < points.size(); ++i) {
+    const double velocity = (points[i - 1].velocity + points[i].velocity) / 2;
+    const double step = points[i].distance - points[i - 1].distance;
+    times[i] = times[i - 1] + (velocity > 0 ? step / velocity : 0);
+  }
+
+  std::vector<TrajectoryState> states;
+  size_t i = 0;
+  for (double time = 0; time < times.back() + PERIOD; time += PERIOD) {
+    const double clamped = std::min(time, times.back());
+    while (i + 2 < points.size() && times[i + 1] < clamped) ++i;
+    const Point& a = points[i];
+    const Point& b = points[i + 1];
+    const double span = times[i + 1] - times[i];
+    const double t =
+        span > 0 ? std::clamp((clamped - times[i]) / span, 0.0, 1.0) : 0;
+    const double velocity = a.velocity + (b.velocity - a.velocity) * t;
+    const double curvature = a.curvature + (b.curvature - a.curvature) * t;
+    TrajectoryState state;
+    state.x = a.x + (b.x - a.x) * t;
+    state.y = a.y + (b.y - a.y) * t;
+    state.theta = a.theta + (b.theta - a.theta) * t;
+    state.velocity = velocity;
+    state.angularVelocity = velocity * curvature;
+    state.acceleration =
+        span > 0 ? (b.velocity - a.velocity) / span : 0;
+    states.push_back(state);
+  }
+  return states;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  Limits limits;
+  const char* files[2] = {};
+  int fileCount = 0;
+  for (int i = 1; i < argc; ++i) {
+    if (!std::strcmp(argv[i], "--acceleration") && i + 1 < argc)
+      limits.acceleration = std::atof(argv[++i]);
+    else if (!std::strcmp(argv[i], "--deceleration") && i + 1 < argc)
+      limits.deceleration = std::atof(argv[++i]);
+    else if (!std::strcmp(argv[i], "--centripetal") && i + 1 < argc)
+      limits.centripetal = std::atof(argv[++i]);
+    else if (fileCount < 2) files[fileCount++] = argv[i];
+    else fileCount = 3;
+  }
+  if (fileCount != 2) {
+    std::fprintf(stderr,
+                 "usage: %s <path.txt> <path.traj> [--acceleration in/s^2] "
+                 "[--deceleration in/s^2] [--centripetal in/s^2]\n",
+                 argv[0]);
+    return 2;
+  }
+
+  std::vector<Bezier> curves;
+  if (!parse(files[0], curves, limits)) return 1;
+  std::vector<Point> points = reparameterize(curves);
+  if (points.size() < 2) {
+    std::fprintf(stderr, "%s: the path is too short\n", files[0]);
+    return 1;
+  }
+  planVelocity(points, limits);
+  const std::vector<TrajectoryState> states = resample(points);
+
+  const uint32_t count = states.size();
+  std::vector<float> arrays(6 * count);
+  for (uint32_t i = 0; i < count; ++i) {
+    arrays[i] = states[i].x;
+    arrays[count + i] = states[i].y;
+    arrays[2 * count + i] = states[i].theta;
+    arrays[3 * count + i] = states[i].velocity;
+    arrays[4 * count + i] = states[i].angularVelocity;
+    arrays[5 * count + i] = states[i].acceleration;
+  }
+
+  TrajectoryHeader header {};
+  std::memcpy(header.magic, Trajectory::MAGIC, sizeof(header.magic));
+  header.version = Trajectory::VERSION;
+  header.headerSize = sizeof(TrajectoryHeader);
+  header.count = count;
+  header.period = PERIOD;
+
+  std::ofstream out(files[1], std::ios::binary);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(arrays.data()),
+            arrays.size() * sizeof(float));
+  if (!out) {
+    std::fprintf(stderr, "%s: can't write\n", files[1]);
+    return 1;
+  }
+  std::printf("%s: %.1fin in %.2fs, %u samples\n", files[1],
+              points.back().distance, (count - 1) * PERIOD, count);
+  return 0;
+}
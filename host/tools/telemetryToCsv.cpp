@@ -0,0 +1,173 @@
+#include "telemetry.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Decodes the binary telemetry in a capture of the robot's stdout, see
+ * include/telemetry.h. Text in between frames is skipped. Writes one CSV per
+ * channel, <prefix>.<channel>.csv, with a time column in ms then a column per
+ * field.
+ *
+ * usage: telemetryToCsv <capture> <prefix>
+ */
+
+namespace {
+struct Schema {
+    std::string name;
+    std::string types;
+    std::vector<std::string> fields;
+};
+
+struct Output {
+    FILE* file = nullptr;
+    uint32_t frames = 0;
+};
+
+uint32_t typeSize(char type) {
+  switch (type) {
+    case 'f':
+    case 'i':
+    case 'I': return 4;
+    case 'h':
+    case 'H': return 2;
+    case 'b':
+    case 'B': return 1;
+    default: return 0;
+  }
+}
+
+template <typename T> T read(const uint8_t* data) {
+  T value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+void printField(FILE* file, char type, const uint8_t* data) {
+  switch (type) {
+    case 'f': std::fprintf(file, ",%g", read<float>(data)); break;
+    case 'i': std::fprintf(file, ",%d", read<int32_t>(data)); break;
+    case 'I': std::fprintf(file, ",%u", read<uint32_t>(data)); break;
+    case 'h': std::fprintf(file, ",%d", read<int16_t>(data)); break;
+    case 'H': std::fprintf(file, ",%u", read<uint16_t>(data)); break;
+    case 'b': std::fprintf(file, ",%d", read<int8_t>(data)); break;
+    case 'B': std::fprintf(file, ",%u", read<uint8_t>(data)); break;
+  }
+}
+
+/** @return false if the payload isn't a well formed schema */
+bool parseSchema(const uint8_t* payload, uint32_t size, uint8_t& id,
+                 Schema& schema) {
+  if (size < 2) return false;
+  id = payload[0];
+  const uint32_t count = payload[1];
+  if (id == telemetry::SCHEMA_CHANNEL || size < 2 + count) return false;
+  schema.types.assign(reinterpret_cast<const char*>(payload + 2), count);
+  for (char type : schema.types)
+    if (typeSize(type) == 0) return false;
+  // the channel name then every field name, each null terminated
+  std::vector<std::string> names;
+  std::string name;
+  for (uint32_t i = 2 + count; i < size; ++i) {
+    if (payload[i] != 0) name += char(payload[i]);
+    else names.push_back(std::move(name)), name.clear();
+  }
+  if (names.size() != count + 1) return false;
+  schema.name = names.front();
+  schema.fields.assign(names.begin() + 1, names.end());
+  return true;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    std::fprintf(stderr, "usage: %s <capture> <prefix>\n", argv[0]);
+    return 2;
+  }
+  std::ifstream file(argv[1], std::ios::binary);
+  if (!file) {
+    std::fprintf(stderr, "%s: can't open\n", argv[1]);
+    return 1;
+  }
+  const std::vector<uint8_t> data {std::istreambuf_iterator<char>(file), {}};
+
+  std::map<uint8_t, Schema> schemas;
+  std::map<uint8_t, Output> outputs;
+  uint32_t badFrames = 0, unknownFrames = 0;
+  size_t i = 0;
+  while (i + telemetry::OVERHEAD <= data.size()) {
+    if (data[i] != telemetry::SYNC[0] || data[i + 1] != telemetry::SYNC[1]) {
+      ++i;
+      continue;
+    }
+    const uint8_t channel = data[i + 2];
+    const uint32_t size = data[i + 3];
+    if (i + size + telemetry::OVERHEAD > data.size()) break;
+    const uint8_t* payload = &data[i + 4];
+    if (telemetry::fletcher16(&data[i + 2], size + 2) !=
+        read<uint16_t>(payload + size)) {
+      // not a frame after all, or a corrupted one
+      ++badFrames;
+      ++i;
+      continue;
+    }
+    i += size + telemetry::OVERHEAD;
+
+    if (channel == telemetry::SCHEMA_CHANNEL) {
+      uint8_t id;
+      Schema schema;
+      if (parseSchema(payload, size, id, schema)) schemas[id] = schema;
+      else ++badFrames;
+      continue;
+    }
+    const auto it = schemas.find(channel);
+    if (it == schemas.end()) {
+      // sent before the first schema we saw
+      ++unknownFrames;
+      continue;
+    }
+    const Schema& schema = it->second;
+    uint32_t expected = 4;
+    for (char type : schema.types) expected += typeSize(type);
+    if (size != expected) {
+      ++badFrames;
+      continue;
+    }
+
+    Output& output = outputs[channel];
+    if (output.file == nullptr) {
+      const std::string path =
+          std::string(argv[2]) + "." + schema.name + ".csv";
+      output.file = std::fopen(path.c_str(), "w");
+      if (output.file == nullptr) {
+        std::fprintf(stderr, "%s: can't write\n", path.c_str());
+        return 1;
+      }
+      std::fprintf(output.file, "time");
+      for (const std::string& field : schema.fields)
+        std::fprintf(output.file, ",%s", field.c_str());
+      std::fprintf(output.file, "\n");
+    }
+    std::fprintf(output.file, "%u", read<uint32_t>(payload));
+    const uint8_t* field = payload + 4;
+    for (char type : schema.types) {
+      printField(output.file, type, field);
+      field += typeSize(type);
+    }
+    std::fprintf(output.file, "\n");
+    ++output.frames;
+  }
+
+  for (auto& [channel, output] : outputs) {
+    std::printf("%s.%s.csv: %u frames\n", argv[2],
+                schemas[channel].name.c_str(), output.frames);
+    std::fclose(output.file);
+  }
+  if (badFrames || unknownFrames)
+    std::printf("skipped %u bad frames, %u frames without a schema\n",
+                badFrames, unknownFrames);
+  return 0;
+}
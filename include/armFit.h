@@ -0,0 +1,110 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+/** @brief Feedforward gains of an arm, fit by ArmFit. */
+struct ArmGains {
+    /** mV to hold the arm up when it's horizontal */
+    float kG = 0;
+    /** angle of the arm when it's horizontal, in degrees */
+    float horizontal = 0;
+    /** mV to overcome friction */
+    float kS = 0;
+    /** mV per degree/s */
+    float kV = 0;
+    /** samples the gains were fit from, 0 if they couldn't be fit */
+    uint32_t samples = 0;
+    /** rms error of the fit, in mV */
+    float rms = 0;
+};
+
+/**
+ * @brief Least squares fit of an arm's feedforward,
+ * voltage = kG*cos(angle - horizontal) + kS*sign(velocity) + kV*velocity,
+ * from samples of a slow voltage sweep.
+ *
+ * kG*cos(angle - horizontal) is fit as a*cos(angle) + b*sin(angle), which
+ * keeps the fit linear and finds the horizontal angle too. Samples are
+ * accumulated into the normal equations, so the fit takes constant memory
+ * however long the sweep is. Used by the lift on the robot and by
+ * host/tools/fitLift.cpp.
+ */
+class ArmFit {
+  public:
+    static constexpr int PARAMS = 4;
+
+    /** @param minVelocity samples slower than this, in deg/s, are friction */
+    explicit ArmFit(float minVelocity = 5) : m_minVelocity(minVelocity) {}
+
+    void reset() { *this = ArmFit(m_minVelocity); }
+
+    /**
+     * @brief Adds a sample, ignored if the arm is slower than minVelocity.
+     * @param angle in degrees
+     * @param velocity in degrees/s
+     * @param voltage in mV
+     */
+    void add(float angle, float velocity, float voltage) {
+      if (std::abs(velocity) < m_minVelocity) return;
+      const double radians = angle * M_PI / 180;
+      const double row[PARAMS] = {std::cos(radians), std::sin(radians),
+                                  velocity > 0 ? 1.0 : -1.0, velocity};
+      for (int i = 0; i < PARAMS; ++i) {
+        for (int j = 0; j < PARAMS; ++j) m_ata[i][j] += row[i] * row[j];
+        m_atv[i] += row[i] * voltage;
+      }
+      m_vtv += double(voltage) * voltage;
+      ++m_samples;
+    }
+
+    /** @return the fit gains, samples 0 if the sweep didn't cover enough */
+    ArmGains solve() const {
+      ArmGains gains;
+      double a[PARAMS][PARAMS + 1];
+      for (int i = 0; i < PARAMS; ++i) {
+        for (int j = 0; j < PARAMS; ++j) a[i][j] = m_ata[i][j];
+        a[i][PARAMS] = m_atv[i];
+      }
+      // gaussian elimination with partial pivoting
+      for (int col = 0; col < PARAMS; ++col) {
+        int pivot = col;
+        for (int row = col + 1; row < PARAMS; ++row)
+          if (std::abs(a[row][col]) > std::abs(a[pivot][col])) pivot = row;
+        // singular when the sweep only moved one way or not at all
+        if (std::abs(a[pivot][col]) < 1e-9 * (1 + m_samples)) return gains;
+        for (int j = 0; j <= PARAMS; ++j) std::swap(a[col][j], a[pivot][j]);
+        for (int row = 0; row < PARAMS; ++row) {
+          if (row == col) continue;
+          const double factor = a[row][col] / a[col][col];
+          for (int j = col; j <= PARAMS; ++j) a[row][j] -= factor * a[col][j];
+        }
+      }
+      double x[PARAMS];
+      for (int i = 0; i < PARAMS; ++i) x[i] = a[i][PARAMS] / a[i][i];
+
+      // residual sum of squares is v'v - 2x'A'v + x'A'Ax
+      double rss = m_vtv;
+      for (int i = 0; i < PARAMS; ++i) {
+        rss -= 2 * x[i] * m_atv[i];
+        for (int j = 0; j < PARAMS; ++j) rss += x[i] * m_ata[i][j] * x[j];
+      }
+      gains.kG = std::hypot(x[0], x[1]);
+      gains.horizontal = std::atan2(x[1], x[0]) * 180 / M_PI;
+      if (gains.horizontal < 0) gains.horizontal += 360;
+      gains.kS = x[2];
+      gains.kV = x[3];
+      gains.samples = m_samples;
+      gains.rms = std::sqrt(std::max(rss, 0.0) / m_samples);
+      return gains;
+    }
+
+    uint32_t getSamples() const { return m_samples; }
+  private:
+    float m_minVelocity;
+    double m_ata[PARAMS][PARAMS] = {};
+    double m_atv[PARAMS] = {};
+    double m_vtv = 0;
+    uint32_t m_samples = 0;
+};
\ No newline at end of file
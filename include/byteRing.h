@@ -0,0 +1,98 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Fixed capacity ring of variable sized records, passed from one
+ * producer task to one consumer task without locking or allocating.
+ *
+ * Each record is stored as its 16 bit size followed by its bytes. A record is
+ * either pushed whole or dropped, so the consumer never sees half of one.
+ *
+ * @tparam Capacity size of the storage in bytes, a power of 2
+ */
+template <uint32_t Capacity> class ByteRing {
+    static_assert(Capacity >= 4 && (Capacity & (Capacity - 1)) == 0,
+                  "ByteRing capacity must be a power of 2");
+  public:
+    /** @brief largest record that can be pushed */
+    static constexpr uint32_t MAX_RECORD = Capacity - sizeof(uint16_t);
+
+    /**
+     * @brief Pushes a record. Must only be called from the producer.
+     *
+     * @return false if there wasn't room for it, in which case it's counted as
+     * dropped
+     */
+    bool push(const void* data, uint16_t size) {
+      const uint32_t head = m_head.load(std::memory_order_relaxed);
+      const uint32_t tail = m_tail.load(std::memory_order_acquire);
+      if (size > MAX_RECORD || Capacity - (head - tail) < size + 2u) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        m_droppedBytes.fetch_add(size, std::memory_order_relaxed);
+        return false;
+      }
+      copyIn(head, &size, sizeof(size));
+      copyIn(head + sizeof(size), data, size);
+      m_head.store(head + sizeof(size) + size, std::memory_order_release);
+      return true;
+    }
+
+    /**
+     * @brief Pops the oldest record. Must only be called from the consumer.
+     *
+     * @param out where to copy the record, truncated to max bytes
+     * @return size of the record, or -1 if the ring is empty
+     */
+    int32_t pop(void* out, uint16_t max) {
+      const uint32_t tail = m_tail.load(std::memory_order_relaxed);
+      const uint32_t head = m_head.load(std::memory_order_acquire);
+      if (head == tail) return -1;
+      uint16_t size;
+      copyOut(tail, &size, sizeof(size));
+      copyOut(tail + sizeof(size), out, std::min(size, max));
+      m_tail.store(tail + sizeof(size) + size, std::memory_order_release);
+      return size;
+    }
+
+    /** @return bytes waiting to be popped, including record sizes */
+    uint32_t used() const {
+      return m_head.load(std::memory_order_acquire) -
+             m_tail.load(std::memory_order_acquire);
+    }
+
+    /** @return records dropped because the ring was full */
+    uint32_t getDropped() const {
+      return m_dropped.load(std::memory_order_relaxed);
+    }
+
+    /** @return bytes dropped because the ring was full */
+    uint32_t getDroppedBytes() const {
+      return m_droppedBytes.load(std::memory_order_relaxed);
+    }
+  private:
+    void copyIn(uint32_t position, const void* data, uint32_t size) {
+      const uint32_t start = position & (Capacity - 1);
+      const uint32_t first = std::min(size, Capacity - start);
+      std::memcpy(m_data + start, data, first);
+      std::memcpy(m_data, static_cast<const uint8_t*>(data) + first,
+                  size - first);
+    }
+
+    void copyOut(uint32_t position, void* data, uint32_t size) const {
+      const uint32_t start = position & (Capacity - 1);
+      const uint32_t first = std::min(size, Capacity - start);
+      std::memcpy(data, m_data + start, first);
+      std::memcpy(static_cast<uint8_t*>(data) + first, m_data, size - first);
+    }
+
+    uint8_t m_data[Capacity];
+    /** total bytes ever pushed, only written by the producer */
+    std::atomic<uint32_t> m_head = 0;
+    /** total bytes ever popped, only written by the consumer */
+    std::atomic<uint32_t> m_tail = 0;
+    std::atomic<uint32_t> m_dropped = 0;
+    std::atomic<uint32_t> m_droppedBytes = 0;
+};
\ No newline at end of file
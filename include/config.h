@@ -74,6 +74,10 @@ struct RobotConfig {
     };
 
     struct LEDs {
+        /**
+         * shares port A with the mogo clamp, so Robot doesn't drive it until
+         * it has a port of its own
+         */
         pros::adi::LED lift;
         pros::adi::LED leftUnderGlow;
         pros::adi::LED rightUnderGlow;
@@ -94,4 +98,4 @@ struct RobotConfig {
   private:
     friend class Robot;
     static const RobotConfig config;
-};
+};
\ No newline at end of file
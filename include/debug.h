@@ -0,0 +1,82 @@
+#pragma once
+#define FMT_HEADER_ONLY
+#include "fmt/core.h"
+#include "logger.h"
+#include "screen.h"
+#include <atomic>
+
+/**
+ * A mask of the debug::Channels that are compiled in. Output on the other
+ * channels compiles away, formatting and all. Competition builds set it to 0,
+ * see COMPETITION in the Makefile.
+ */
+#ifndef DEBUG_CHANNELS
+#define DEBUG_CHANNELS 0xFFFFFFFF
+#endif
+
+/**
+ * Debug output from subsystems, to the console through logger::debug or to a
+ * line of the brain screen through Screen. Each channel can be compiled out,
+ * and is rate limited at runtime so update() can call it every tick.
+ */
+namespace debug {
+enum Channel : uint32_t { LIFT, INTAKE, CHANNEL_COUNT };
+
+/** @return whether channel is compiled in */
+constexpr bool enabled(Channel channel) {
+  return (DEBUG_CHANNELS >> channel) & 1;
+}
+
+/** @brief ms between outputs of each channel, 0 to output every call */
+inline std::atomic<uint32_t> intervals[CHANNEL_COUNT] = {200, 200};
+
+/** @brief Sets the ms between outputs of channel at runtime. */
+inline void setInterval(Channel channel, uint32_t interval) {
+  intervals[channel] = interval;
+}
+
+/**
+ * @return whether the output last done at last should be done again now,
+ * updating last if so
+ */
+inline bool due(Channel channel, std::atomic<uint32_t>& last) {
+  const uint32_t now = pros::millis();
+  const uint32_t previous = last.load(std::memory_order_relaxed);
+  if (previous != 0 &&
+      now - previous < intervals[channel].load(std::memory_order_relaxed))
+    return false;
+  last.store(now == 0 ? 1 : now, std::memory_order_relaxed);
+  return true;
+}
+
+/** @brief when each channel was last printed, 0 if never */
+inline std::atomic<uint32_t> lastPrint[CHANNEL_COUNT] {};
+/** @brief when each line of the screen was last printed, 0 if never */
+inline std::atomic<uint32_t> lastLcd[CHANNEL_COUNT][Screen::LINES] {};
+
+/** @brief Logs a debug message on channel, at most once per interval. */
+template <Channel channel, typename... T>
+void print(fmt::format_string<T...> format, T&&... args) {
+  if constexpr (enabled(channel)) {
+    if (!due(channel, lastPrint[channel])) return;
+    logger::debug(format, std::forward<T>(args)...);
+  }
+}
+
+/**
+ * @brief Sets the text of a line of the brain screen, at most once per
+ * interval for each line. The screen task draws it.
+ */
+template <Channel channel, typename... T>
+void lcd(int line, fmt::format_string<T...> format, T&&... args) {
+  if constexpr (enabled(channel)) {
+    if (line < 0 || line >= Screen::LINES) return;
+    if (!due(channel, lastLcd[channel][line])) return;
+    char text[Screen::LINE_LENGTH];
+    const auto result = fmt::format_to_n(text, sizeof(text) - 1, format,
+                                         std::forward<T>(args)...);
+    *result.out = '\0';
+    Screen::get()->setText(line, text);
+  }
+}
+} // namespace debug
\ No newline at end of file
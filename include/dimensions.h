@@ -43,6 +43,9 @@ namespace robot {
 constexpr float TRACK_WIDTH = 27.0 / 2;
 constexpr float DRIVE_WIDTH = 29.0 / 2;
 constexpr float DRIVE_LENGTH = 30.0 / 2;
+constexpr float DRIVE_WHEEL_DIAMETER = 4.0;
+/** rpm of the drive wheels at full speed */
+constexpr float DRIVE_WHEEL_RPM = 200;
 
 } // namespace robot
 
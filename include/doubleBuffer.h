@@ -0,0 +1,49 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief Hands the latest value from one writer task to any number of reader
+ * tasks without locking. Neither side ever blocks the other.
+ *
+ * The writer fills whichever buffer isn't published, then publishes it.
+ * Each buffer has a sequence number that is odd while it's being written,
+ * so a reader that gets overtaken by two writes notices and reads again.
+ */
+template <typename T> class DoubleBuffer {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "DoubleBuffer copies values byte by byte");
+  public:
+    /** @brief Publishes value. Must only be called from one task. */
+    void write(const T& value) {
+      const uint32_t next = m_published.load(std::memory_order_relaxed) ^ 1;
+      Slot& slot = m_slots[next];
+      slot.sequence.fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      slot.value = value;
+      slot.sequence.fetch_add(1, std::memory_order_release);
+      m_published.store(next, std::memory_order_release);
+    }
+
+    /** @returns the last published value */
+    T read() const {
+      while (true) {
+        const Slot& slot = m_slots[m_published.load(std::memory_order_acquire)];
+        const uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence & 1) continue;
+        const T value = slot.value;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == sequence)
+          return value;
+      }
+    }
+  private:
+    struct Slot {
+        std::atomic<uint32_t> sequence = 0;
+        T value {};
+    };
+
+    Slot m_slots[2];
+    std::atomic<uint32_t> m_published = 0;
+};
\ No newline at end of file
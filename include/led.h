@@ -1,16 +1,16 @@
+#include "ledCompositor.h"
+#include "ledEffects.h"
 #include "pros/adi.hpp"
 #include <cfloat>
+#include <atomic>
 #include <climits>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
-#include <functional>
 #include <vector>
 
 #pragma once
 
-using HexRGB = uint32_t;
-
 #define COLOR_OPERATOR(color_class, op, channel1, channel2, channel3)          \
   template <typename U, typename R = decltype(channel1 op std::declval<U>())>  \
   color_class<R> operator op(const U & operand) const {                        \
@@ -121,13 +121,27 @@ template <typename T> RGB<T> hsvToRgb(const HSV<T>& hsv) {
 
 /**
  * @brief Provides additional functionality to the LED object
+ *
+ * Pixels are drawn into a frame that is viewed through a rotation, so
+ * scrolling the strip only moves the rotation. The frame is only copied,
+ * rotated, when it's sent with update(), and LedCompositor sends it to the
+ * strip.
+ *
+ * The frame belongs to the task drawing on the strip, which should be one
+ * task at a time. The compositor only ever reads the copy handed over by
+ * update(), under a lock.
  */
 class LedStrip : protected pros::adi::LED {
   public:
     LedStrip(pros::adi::LED& strip);
+    ~LedStrip();
+
+    LedStrip(const LedStrip&) = delete;
+    LedStrip& operator=(const LedStrip&) = delete;
 
     /**
-     * @brief Sets the color of the specified pixel on the strip.
+     * @brief Sets the color of the specified pixel on the strip, without
+     * sending the frame. Call update() once the whole frame is drawn.
      *
      * @param index Zero based index of desired pixel.
      * @param color Desired color.
@@ -153,30 +167,77 @@ class LedStrip : protected pros::adi::LED {
     void setGradient(uint32_t startColor, uint32_t endColor);
 
     /**
-     * @brief Shifts colors of all pixels by distance pixel positions.
-     * So, if the strip was [red, green, blue], then after this a shift
-     * with distance 1, it would then be [blue, red, green].
+     * @brief Shifts colors of all pixels by distance pixel positions, then
+     * sends the frame. So, if the strip was [red, green, blue], then after
+     * this a shift with distance 1, it would then be [blue, red, green].
      * @param distance How far the pixels should be shifted.
      */
     void shift(size_t distance = 1);
 
-    void
-    cycle(float speed,
-          std::function<uint32_t(HexRGB a, HexRGB b, float t)> interpolator);
+    /**
+     * @brief Shifts colors of all pixels like shift(), without sending the
+     * frame. Doesn't touch any pixels.
+     * @param distance How far the pixels should be shifted.
+     */
+    void rotate(size_t distance = 1);
+
+    /**
+     * @brief Renders a frame of effect, gamma corrects it and sends it to the
+     * strip. Call it every frame to animate the strip.
+     * @param effect The animation to show.
+     * @param time The time of the frame, usually pros::millis().
+     */
+    void show(LedEffect& effect, uint32_t time);
 
-    /** @brief Force update the led. */
+    /**
+     * @brief Hands the frame, as currently rotated, to LedCompositor to send
+     * to the strip. Never waits on the strip itself, only on the compositor
+     * taking the last frame handed over.
+     */
     void update();
 
     /** @return the length of the strip */
     size_t getLength() const;
 
-    /** @return the color at index */
+    /** @return the color at index, after rotation */
     const HexRGB& operator[](int index) const;
-    /** @return the color at index */
+    /** @return the color at index, after rotation */
     const HexRGB& at(int index) const;
 
+    /**
+     * @return the frame before rotation. Pixel i of the frame is shown at
+     * (i + getRotation()) % getLength().
+     */
     std::vector<HexRGB>& getBuffer();
     const std::vector<HexRGB>& getBuffer() const;
+
+    /** @return how far the frame is rotated */
+    size_t getRotation() const;
   private:
     using super = pros::adi::LED;
+    friend class LedCompositor;
+
+    /**
+     * @brief Swaps the frame handed over by update() into the strip's buffer.
+     * Only called by the compositor.
+     * @return false if no frame was handed over since the last swap
+     */
+    bool swapFrames();
+    /** @brief Sends the strip's buffer. Only called by the compositor. */
+    void flush();
+    /** @return the smart port of the ADI the strip is on */
+    uint8_t getPort() const;
+
+    /** @return index into m_frame of the pixel shown at index */
+    size_t frameIndex(size_t index) const;
+
+    std::vector<HexRGB> m_frame;
+    size_t m_rotation = 0;
+
+    /** @brief the last frame handed over by update(), not yet sent */
+    std::vector<HexRGB> m_handover;
+    /** @brief guards m_handover */
+    pros::Mutex m_handoverMutex;
+    /** @brief set when m_handover holds a frame that hasn't been sent */
+    std::atomic<bool> m_dirty = false;
 };
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * Fixed point color math for the LED strips. Nothing here touches floats,
+ * hue to RGB and gamma correction are table lookups.
+ */
+
+using HexRGB = uint32_t;
+
+/**
+ * @brief An HSV color in fixed point.
+ */
+struct HSV8 {
+    /** hue, a full turn is 65536 so it wraps on its own */
+    uint16_t h;
+    /** saturation, 255 is fully saturated */
+    uint8_t s;
+    /** value, 255 is full brightness */
+    uint8_t v;
+};
+
+/** @return a * b / 256, rounded so that scale8(a, 255) == a */
+constexpr uint8_t scale8(uint8_t a, uint8_t b) { return (a * (b + 1)) >> 8; }
+
+constexpr uint8_t red(HexRGB color) { return color >> 16; }
+constexpr uint8_t green(HexRGB color) { return color >> 8; }
+constexpr uint8_t blue(HexRGB color) { return color; }
+
+constexpr HexRGB hex(uint8_t r, uint8_t g, uint8_t b) {
+  return HexRGB(r) << 16 | HexRGB(g) << 8 | b;
+}
+
+/** @return every channel of color scaled by brightness / 256 */
+constexpr HexRGB scaleColor(HexRGB color, uint8_t brightness) {
+  return hex(scale8(red(color), brightness), scale8(green(color), brightness),
+             scale8(blue(color), brightness));
+}
+
+/** @return the color t / 255 of the way from a to b */
+constexpr HexRGB lerpColor(HexRGB a, HexRGB b, uint8_t t) {
+  const auto lerp = [t](uint8_t x, uint8_t y) -> uint8_t {
+    return x + (y - x) * t / 255;
+  };
+  return hex(lerp(red(a), red(b)), lerp(green(a), green(b)),
+             lerp(blue(a), blue(b)));
+}
+
+HexRGB hsvToHex(HSV8 hsv);
+HSV8 hexToHsv(HexRGB color);
+
+/**
+ * @return hsv t / 255 of the way from a to b. Hue goes the way the numbers do
+ * rather than the short way around.
+ */
+HSV8 lerpHsv(HSV8 a, HSV8 b, uint8_t t);
+
+/**
+ * @brief Gamma corrects a linear brightness, so that steps in brightness look
+ * even on the strip.
+ */
+uint8_t gamma8(uint8_t value);
+
+/** @brief Gamma corrects each channel of color */
+HexRGB gammaCorrect(HexRGB color);
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+#include "pros/rtos.hpp"
+#include <vector>
+
+class LedStrip;
+
+/**
+ * @brief Sends every LedStrip's frames to the strips from one low priority
+ * task. Strips hand over frames from any task with LedStrip::update(), and
+ * only the latest frame of a strip is sent. Strips that haven't changed aren't
+ * sent, and each ADI port is sent at most once per Config::flushInterval, so
+ * the LEDs can't crowd out everything else on an ADI expander. Follows the
+ * Singleton pattern.
+ */
+class LedCompositor {
+  public:
+    struct Config {
+        /** least ms between sends to strips on the same ADI port */
+        uint32_t flushInterval;
+
+        /** default config */
+        static Config config;
+    };
+
+    /**
+     * @brief Gets the LedCompositor instance.
+     * If it has not been previously constructed (instance == nullptr), then
+     * this method will construct it.
+     */
+    static LedCompositor* get();
+
+    /** @brief Wakes the task to send frames that are waiting. */
+    void wake();
+  private:
+    friend class LedStrip;
+
+    /** @brief largest smart port number, the brain's own ADI is 22 */
+    static constexpr uint8_t MAX_PORT = 22;
+
+    /** @brief Starts sending frames from strip. */
+    void addStrip(LedStrip* strip);
+    /**
+     * @brief Stops sending frames from strip. Once this returns, the task is
+     * guaranteed to be done with the strip.
+     */
+    void removeStrip(LedStrip* strip);
+
+    /**
+     * @brief Sends the latest frame of every strip that changed, if its port
+     * allows it.
+     *
+     * @return ms until a strip that is waiting on its port can be sent
+     */
+    uint32_t compose();
+
+    struct Entry {
+        LedStrip* strip;
+        /** when the strip was last sent, in ms */
+        uint32_t lastFlush;
+    };
+
+    const Config& m_config;
+    /** @brief guards m_strips, held by the task while it sends frames */
+    pros::Mutex m_mutex;
+    std::vector<Entry> m_strips;
+    /** @brief when each smart port can next be sent to, in ms */
+    uint32_t m_portFree[MAX_PORT + 1] {};
+    pros::Task m_task;
+
+    /** @brief starts the compositor task */
+    LedCompositor(const Config& config);
+    /**
+     * @brief Should ever be one instance of LedCompositor, and that's this
+     * one.
+     */
+    static LedCompositor* instance;
+};
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+#include "ledColor.h"
+#include <cstddef>
+
+/**
+ * @brief An animation for an LED strip. Renders a whole frame for a point in
+ * time, so frames can be skipped or rendered late without the animation
+ * drifting.
+ */
+class LedEffect {
+  public:
+    virtual ~LedEffect() = default;
+
+    /**
+     * @brief Renders the frame at time into pixels.
+     *
+     * @param pixels linear colors, gamma correction is left to the strip
+     * @param length number of pixels
+     * @param time ms since some fixed point, usually pros::millis()
+     */
+    virtual void render(HexRGB* pixels, size_t length, uint32_t time) = 0;
+};
+
+/** @brief Fades from start on the first pixel to end on the last in HSV */
+class GradientEffect : public LedEffect {
+  public:
+    GradientEffect(HexRGB start, HexRGB end);
+
+    void render(HexRGB* pixels, size_t length, uint32_t time) override;
+  private:
+    const HSV8 m_start;
+    const HSV8 m_end;
+};
+
+/**
+ * @brief A gradient from start to end and back again that scrolls along the
+ * strip, moving smoothly between pixels.
+ */
+class CycleEffect : public LedEffect {
+  public:
+    /** @param speed pixels per second, negative scrolls backwards */
+    CycleEffect(HexRGB start, HexRGB end, float speed);
+
+    void render(HexRGB* pixels, size_t length, uint32_t time) override;
+  private:
+    const HSV8 m_start;
+    const HSV8 m_end;
+    /** pixels per ms, in 16.16 fixed point */
+    const int32_t m_speed;
+};
+
+/** @brief Fades the whole strip in and out */
+class BreatheEffect : public LedEffect {
+  public:
+    /** @param period ms per breath */
+    BreatheEffect(HexRGB color, uint32_t period);
+
+    void render(HexRGB* pixels, size_t length, uint32_t time) override;
+  private:
+    const HexRGB m_color;
+    const uint32_t m_period;
+};
+
+/** @brief A dot with a fading tail that runs along the strip and wraps */
+class ChaseEffect : public LedEffect {
+  public:
+    /**
+     * @param tail pixels behind the dot that fade into the background
+     * @param speed pixels per second
+     */
+    ChaseEffect(HexRGB color, HexRGB background, uint32_t tail, float speed);
+
+    void render(HexRGB* pixels, size_t length, uint32_t time) override;
+  private:
+    const HexRGB m_color;
+    const HexRGB m_background;
+    const uint32_t m_tail;
+    /** pixels per ms, in 16.16 fixed point */
+    const int32_t m_speed;
+};
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+#include "byteRing.h"
+#include "pros/rtos.hpp"
+
+/**
+ * @brief Buffers log output from any task and writes it to stdout from its own
+ * low priority task, so that logging from a control loop never blocks on a
+ * mutex, waits on the serial port or calls the allocator. Replaces
+ * lemlib::Buffer for robot code. Follows the Singleton pattern.
+ *
+ * Writers share a few single producer rings. A writer takes the first ring no
+ * other writer is in the middle of, so the rings only ever have one producer.
+ * Messages are dropped, and counted, when every ring is busy or the one taken
+ * is full.
+ */
+class LogBuffer {
+  public:
+    /** @brief number of rings writers can take */
+    static constexpr uint32_t RINGS = 4;
+    /** @brief bytes of storage in each ring */
+    static constexpr uint32_t RING_CAPACITY = 2048;
+    /** @brief longest message, longer messages are truncated */
+    static constexpr uint32_t MAX_MESSAGE = 256;
+    /** @brief ms between writes to stdout */
+    static constexpr uint32_t PERIOD = 10;
+
+    struct Stats {
+        /** messages buffered */
+        uint32_t written;
+        /** messages dropped because their ring was full */
+        uint32_t dropped;
+        /** messages dropped because every ring was busy */
+        uint32_t contended;
+    };
+
+    /**
+     * @brief Gets the LogBuffer instance, constructing it and starting its
+     * task on the first call. Should be called during initialize() so nothing
+     * is allocated later.
+     */
+    static LogBuffer* get();
+
+    /**
+     * @brief Buffers a message. Safe to call from any task, never blocks.
+     *
+     * @return false if the message was dropped
+     */
+    bool write(const char* message, uint32_t size);
+
+    Stats getStats() const;
+  private:
+    struct Ring {
+        /** set while a writer is pushing to the ring */
+        std::atomic<bool> busy = false;
+        ByteRing<RING_CAPACITY> ring;
+    };
+
+    Ring m_rings[RINGS];
+    std::atomic<uint32_t> m_written = 0;
+    std::atomic<uint32_t> m_contended = 0;
+    /** drops that have already been reported */
+    uint32_t m_reportedDrops = 0;
+    pros::Task m_task;
+
+    /** @brief writes every buffered message to stdout. Only called by task. */
+    void drain();
+
+    /** @brief starts the task */
+    LogBuffer();
+    /**
+     * @brief Should ever be one instance of LogBuffer, and that's this one.
+     */
+    static LogBuffer* instance;
+};
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+#define FMT_HEADER_ONLY
+#include "fmt/core.h"
+#include "lemlib/logger/message.hpp"
+#include "logBuffer.h"
+#include <atomic>
+
+/**
+ * The lowest lemlib::Level that is compiled in, as an int. Messages below it
+ * cost nothing, their calls compile away. Build with ex. -DLOG_MIN_LEVEL=2 to
+ * drop info and debug messages.
+ */
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 0
+#endif
+
+/**
+ * Logging that is cheap enough for control loops. The level is checked before
+ * anything is formatted, and messages are formatted with fmt into a buffer on
+ * the stack, then handed to LogBuffer. Nothing is allocated and nothing
+ * blocks.
+ *
+ * Levels follow lemlib's order: INFO, DEBUG, WARN, ERROR, FATAL.
+ */
+namespace logger {
+constexpr lemlib::Level MIN_LEVEL = static_cast<lemlib::Level>(LOG_MIN_LEVEL);
+
+/** @brief levels below this are skipped at runtime */
+inline std::atomic<lemlib::Level> lowestLevel = MIN_LEVEL;
+
+/** @brief Sets the lowest level that is logged, at least MIN_LEVEL. */
+inline void setLowestLevel(lemlib::Level level) { lowestLevel = level; }
+
+/** @return the name of level, without allocating like lemlib's format_as */
+constexpr const char* levelName(lemlib::Level level) {
+  switch (level) {
+    case lemlib::Level::INFO: return "INFO";
+    case lemlib::Level::DEBUG: return "DEBUG";
+    case lemlib::Level::WARN: return "WARN";
+    case lemlib::Level::ERROR: return "ERROR";
+    case lemlib::Level::FATAL: return "FATAL";
+  }
+  return "?";
+}
+
+/**
+ * @brief Logs a message as "[time] LEVEL: message". Messages longer than
+ * LogBuffer::MAX_MESSAGE are truncated.
+ *
+ * @param format fmt format string, checked at compile time
+ */
+template <lemlib::Level level, typename... T>
+void log(fmt::format_string<T...> format, T&&... args) {
+  if constexpr (level >= MIN_LEVEL) {
+    if (level < lowestLevel.load(std::memory_order_relaxed)) return;
+    char message[LogBuffer::MAX_MESSAGE];
+    // leave room for the newline
+    constexpr size_t room = sizeof(message) - 1;
+    char* end = fmt::format_to_n(message, room, "[{}] {}: ", pros::millis(),
+                                 levelName(level))
+                    .out;
+    end = fmt::format_to_n(end, room - (end - message), format,
+                           std::forward<T>(args)...)
+              .out;
+    *end++ = '\n';
+    LogBuffer::get()->write(message, end - message);
+  }
+}
+
+template <typename... T>
+void info(fmt::format_string<T...> format, T&&... args) {
+  log<lemlib::Level::INFO>(format, std::forward<T>(args)...);
+}
+
+template <typename... T>
+void debug(fmt::format_string<T...> format, T&&... args) {
+  log<lemlib::Level::DEBUG>(format, std::forward<T>(args)...);
+}
+
+template <typename... T>
+void warn(fmt::format_string<T...> format, T&&... args) {
+  log<lemlib::Level::WARN>(format, std::forward<T>(args)...);
+}
+
+template <typename... T>
+void error(fmt::format_string<T...> format, T&&... args) {
+  log<lemlib::Level::ERROR>(format, std::forward<T>(args)...);
+}
+
+template <typename... T>
+void fatal(fmt::format_string<T...> format, T&&... args) {
+  log<lemlib::Level::FATAL>(format, std::forward<T>(args)...);
+}
+} // namespace logger
\ No newline at end of file
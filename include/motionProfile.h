@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/** @brief Limits on a motion profile, in units of position and seconds */
+struct ProfileConstraints {
+    float maxVelocity;
+    float maxAcceleration;
+    /** 0 for a trapezoidal profile, otherwise the profile is an S-curve */
+    float maxJerk;
+};
+
+/** @brief Where a profile wants the mechanism at some time */
+struct ProfilePoint {
+    float position;
+    float velocity;
+    float acceleration;
+};
+
+/**
+ * @brief A time parameterized move between two positions, starting and ending
+ * at rest. Sampled once when generated, so following it is a table lookup.
+ *
+ * The S-curve is a trapezoidal profile with its velocity averaged over the
+ * time it takes to reach maxAcceleration at maxJerk, which limits jerk
+ * without any extra segments to solve for.
+ */
+class MotionProfile {
+  public:
+    MotionProfile() = default;
+
+    /**
+     * @brief Generates the profile from start to end, reusing the storage of
+     * the last profile where it can.
+     *
+     * @param dt seconds between samples, usually the update period
+     */
+    void generate(float start, float end, const ProfileConstraints& constraints,
+                  float dt);
+
+    /**
+     * @brief Reserves room so moves up to distance long don't allocate when
+     * generated.
+     */
+    void reserve(float distance, const ProfileConstraints& constraints,
+                 float dt);
+
+    /**
+     * @return the point the profile is at after time seconds, the end once
+     * it's finished
+     */
+    ProfilePoint at(float time) const;
+
+    /** @return how long the move takes, in seconds */
+    float getDuration() const;
+    float getStart() const;
+    float getEnd() const;
+    bool isEmpty() const;
+  private:
+    /** @return samples needed for a move of distance */
+    static uint32_t sampleCount(float distance,
+                                const ProfileConstraints& constraints,
+                                float dt);
+
+    std::vector<ProfilePoint> m_points;
+    float m_dt = 0;
+    float m_start = 0;
+    float m_end = 0;
+};
\ No newline at end of file
@@ -0,0 +1,323 @@
+#pragma once
+#include "byteRing.h"
+#include "lemlib/chassis/chassis.hpp"
+#include "motions.h"
+#include "odometry.h"
+#include "pros/rtos.hpp"
+#include <atomic>
+#include <variant>
+
+class MotionQueue;
+
+/**
+ * @brief Refers to a motion queued on the MotionQueue, to wait for it, cancel
+ * it or be called back as it goes. Cheap to copy.
+ *
+ * Callbacks are called on the motion executor's task, in the same step the
+ * motion gets far enough, so they should only do something quick like
+ * starting the intake. They're plain function pointers, so nothing is
+ * allocated, and lambdas can't capture.
+ */
+class MotionHandle {
+  public:
+    using Callback = void (*)();
+
+    /** @brief A handle to no motion, as if it had already finished */
+    MotionHandle() = default;
+
+    /** @return false if the motion couldn't be queued */
+    explicit operator bool() const { return m_queue != nullptr; }
+
+    /**
+     * @brief Blocks until the motion has ended, however it ended. Any number
+     * of tasks can await the same motion.
+     */
+    void await() const;
+    /**
+     * @brief Blocks until the motion has ended or timeout ms have passed
+     * @return whether the motion has ended
+     */
+    bool waitFor(uint32_t timeout) const;
+    /** @return whether the motion has ended, however it ended */
+    bool isDone() const;
+
+    /**
+     * @brief Calls callback once the robot has travelled distance since the
+     * motion started, in inches, or degrees for turns. Like
+     * lemlib::Chassis::waitUntil.
+     */
+    MotionHandle& onDistance(float distance, Callback callback);
+    /**
+     * @brief Calls callback once fraction of the motion is done, 0-1. A
+     * motion that finishes is all done, so a callback for 1 is called when
+     * it finishes, but not if it times out or is cancelled.
+     */
+    MotionHandle& onProgress(float fraction, Callback callback);
+    /**
+     * @brief Ends the motion if it's being driven, or drops it if it's still
+     * queued. The motions after it carry on.
+     */
+    void cancel();
+  private:
+    friend class MotionQueue;
+    MotionHandle(MotionQueue* queue, uint32_t id) : m_queue(queue), m_id(id) {}
+    MotionHandle& addTrigger(bool progress, float threshold, Callback callback);
+
+    MotionQueue* m_queue = nullptr;
+    uint32_t m_id = 0;
+};
+
+/**
+ * @brief Bounded queue of motions, driven back to back by one persistent
+ * motion executor task.
+ *
+ * Each motion is made into a MotionState in place when it reaches the front
+ * of the queue, and stepped every period with the measured time since the
+ * last step. When one ends the next starts in the same period, so no
+ * motion call ever creates a task or waits for one to start.
+ *
+ * Unlike lemlib's motions, a motion that's followed by another one doesn't
+ * slow down to stop at its target. It plans to pass through it at the speed
+ * the corner into the next motion allows, switches to the next motion within
+ * the blend distance of it and carries its speed over. Only the last motion
+ * queued, or one with the robot having to reverse or turn in place after it,
+ * comes to a stop.
+ *
+ * Speeds are planned in inches/s against the drivetrain's top speed, with
+ * constant acceleration and deceleration limits, and sent to the motors as
+ * feedforward. Motions should be queued from one task at a time, and not
+ * mixed with lemlib's motions.
+ */
+class MotionQueue {
+  public:
+    /** @brief size of the queue's storage, in bytes */
+    static constexpr uint32_t QUEUE_SIZE = 4096;
+    /**
+     * @brief motions that can have live handles, more than fit in the queue
+     * so a motion's record isn't reused while it's queued
+     */
+    static constexpr uint32_t RECORDS = 64;
+    /** @brief callbacks that can be added to one motion */
+    static constexpr uint32_t MAX_CALLBACKS = 4;
+    /**
+     * @brief tasks that can block on one motion at once, any more poll for
+     * it instead
+     */
+    static constexpr uint32_t MAX_WAITERS = 4;
+
+    struct Config {
+        /** ms between steps of the motion being driven */
+        uint32_t period;
+        /** inches/s^2 the robot speeds up at */
+        float maxAcceleration;
+        /** inches/s^2 the robot plans to slow down at */
+        float maxDeceleration;
+        /** degrees/s^2 the robot speeds up its turns at */
+        float maxAngularAcceleration;
+        /** degrees/s^2 the robot plans to slow down its turns at */
+        float maxAngularDeceleration;
+        /** degrees/s the robot turns at per degree it's facing off the point */
+        float kHeading;
+        /** inches from its point a move followed by another one ends */
+        float blendDistance;
+        /** degrees from its heading a turn followed by a move ends */
+        float blendAngle;
+        /** inches from its point the last move ends */
+        float settleDistance;
+        /** degrees from its heading the last turn ends */
+        float settleAngle;
+        /**
+         * RAMSETE gain for tracking trajectories, 1/inches^2. Higher corrects
+         * off track error more aggressively.
+         */
+        float ramseteB;
+        /** RAMSETE damping for tracking trajectories, 0-1 */
+        float ramseteZeta;
+        /**
+         * seconds of a trajectory's acceleration added to its speed, to make
+         * up for the drive motors lagging behind what they're sent
+         */
+        float kAcceleration;
+
+        /** default config */
+        static Config config;
+    };
+
+    MotionQueue(const lemlib::Drivetrain& drivetrain, Odometry& odom,
+                const Config& config);
+
+    /**
+     * @brief Queues a move to a point, see lemlib::Chassis::moveToPoint.
+     * minSpeed is the slowest the robot passes through the point, and as
+     * with lemlib, a move with one ends within earlyExitRange of it instead
+     * of settling on it.
+     *
+     * @return a handle to the motion, false if the queue is full
+     */
+    MotionHandle moveToPoint(float x, float y, int timeout,
+                             lemlib::MoveToPointParams params = {});
+    /**
+     * @brief Queues a move to a pose, theta in degrees, see
+     * lemlib::Chassis::moveToPose. The robot drives at a carrot point lead
+     * of the way back from the pose along theta, then lines up with theta
+     * within the blend distance. Passing through it blends into a move
+     * after it like moveToPoint does. horizontalDrift isn't used, the
+     * speed through curves is only limited by the turn slowing it down.
+     *
+     * @return a handle to the motion, false if the queue is full
+     */
+    MotionHandle moveToPose(float x, float y, float theta, int timeout,
+                            lemlib::MoveToPoseParams params = {});
+    /**
+     * @brief Queues a turn to a heading in degrees, see
+     * lemlib::Chassis::turnToHeading.
+     *
+     * @return a handle to the motion, false if the queue is full
+     */
+    MotionHandle turnToHeading(float theta, int timeout,
+                               lemlib::TurnToHeadingParams params = {});
+    /**
+     * @brief Queues a turn to face a point, or face away from it if not
+     * forwards, see lemlib::Chassis::turnToPoint.
+     *
+     * @return a handle to the motion, false if the queue is full
+     */
+    MotionHandle turnToPoint(float x, float y, int timeout,
+                             lemlib::TurnToPointParams params = {});
+    /**
+     * @brief Queues following a path with pure pursuit, see Robot::follow.
+     *
+     * @param slew most the path's speed can change per step, 0 for no limit
+     * @return a handle to the motion, false if the queue is full or the
+     * path isn't valid
+     */
+    MotionHandle follow(const Path& path, float lookahead, int timeout,
+                        bool forwards = true, float slew = 0);
+    /**
+     * @brief Queues tracking a trajectory by time with RAMSETE: the robot
+     * drives the trajectory's speed and turn at each moment, corrected
+     * towards where the trajectory says it should be by then. It ends when
+     * the trajectory does, so it arrives on time.
+     *
+     * Unlike following a path, the robot should start on the trajectory's
+     * first pose, since it's chasing where it should be rather than
+     * rejoining the path.
+     *
+     * @return a handle to the motion, false if the queue is full or the
+     * trajectory isn't valid
+     */
+    MotionHandle follow(const Trajectory& trajectory, int timeout);
+
+    /**
+     * @brief Blocks until every queued motion has ended, woken by the
+     * executor rather than polling
+     */
+    void waitUntilDone();
+    /**
+     * @brief Drops every motion queued so far and stops the one being
+     * driven, on the executor's next step. Motions queued after it aren't
+     * affected, even if the executor hasn't got round to the clear yet.
+     */
+    void clear();
+    /** @return motions queued or being driven */
+    uint32_t getPending() const;
+  private:
+    friend class MotionHandle;
+    friend class MoveToPointMotion;
+    friend class TurnToHeadingMotion;
+    friend class FollowMotion;
+    friend class TrajectoryMotion;
+
+    const lemlib::Drivetrain& m_drivetrain;
+    Odometry& m_odom;
+    const Config& m_config;
+    pros::Task* m_task = nullptr;
+
+    /**
+     * @brief What a MotionHandle refers to. Callbacks are added by the task
+     * queueing motions and called by the executor, which owns the rest.
+     */
+    struct Record {
+        struct Trigger {
+            /** whether threshold is progress rather than distance */
+            bool progress;
+            float threshold;
+            MotionHandle::Callback callback;
+        };
+        /** id of the motion using the record */
+        std::atomic<uint32_t> id = 0;
+        std::atomic<bool> done = true;
+        std::atomic<bool> cancelled = false;
+        /** tasks blocked in MotionHandle::await, woken when it's done */
+        std::atomic<pros::task_t> waiters[MAX_WAITERS] = {};
+        Trigger triggers[MAX_CALLBACKS];
+        std::atomic<uint32_t> triggerCount = 0;
+        /** bit n is set once triggers[n] has been called */
+        uint32_t fired = 0;
+        /** inches or degrees travelled since the motion started */
+        float travelled = 0;
+    };
+
+    Record m_records[RECORDS];
+    uint32_t m_lastId = 0;
+    /** record of the motion being driven */
+    Record* m_record = nullptr;
+    /** pose as of the last step, to add up the distance travelled */
+    lemlib::Pose m_lastPose {0, 0, 0};
+
+    ByteRing<QUEUE_SIZE> m_queue;
+    std::atomic<uint32_t> m_pending = 0;
+    /** id of the last motion queued before clear(), 0 if never cleared */
+    std::atomic<uint32_t> m_clearedThrough = 0;
+
+    /** the motion being driven, made in place so nothing is allocated */
+    std::variant<std::monostate, MoveToPointMotion, TurnToHeadingMotion,
+                 FollowMotion, TrajectoryMotion>
+        m_state;
+    MotionState* m_current = nullptr;
+    uint32_t m_timeout = 0;
+    uint32_t m_startedAt = 0;
+    /** the motion after the one being driven, popped early to plan for it */
+    Motion m_next;
+    bool m_hasNext = false;
+    /** speed sent to the motors, inches/s forwards */
+    float m_speed = 0;
+    /** turn sent to the motors, radians/s clockwise */
+    float m_angular = 0;
+
+    MotionHandle push(Motion motion);
+    Record& record(uint32_t id);
+    /** @brief Marks the record done and wakes everyone awaiting it */
+    void complete(Record& record);
+    /** @brief Calls the callbacks of the motion being driven that are due */
+    void trigger(float progress);
+    /** @brief Pops the next motion into m_next, if there isn't one already */
+    bool peek();
+    /**
+     * @brief Steps the motion being driven, starting the next one if it
+     * ends, on the executor's task
+     * @return false if there are no motions left to drive
+     */
+    bool update(float dt);
+    /** @brief Makes the next motion the one being driven and starts it */
+    bool begin();
+    /**
+     * @brief Ends the motion being driven
+     * @param finished whether it ended by finishing, rather than timing out
+     * or being cancelled
+     */
+    void finish(bool finished);
+    /** @return whether clear() was called after the motion was queued */
+    bool cleared(uint32_t id) const;
+    /**
+     * @return inches/s to pass through the point of a move at, given what
+     * comes after it
+     */
+    float exitSpeed(const Motion& motion, const lemlib::Pose& pose);
+    /** @return whether motion drives to a point, so can be blended into */
+    static bool isMove(const Motion& motion);
+    /** @brief Sends m_speed and m_angular to the drivetrain */
+    void output();
+    /** @return top speed of the drivetrain, inches/s */
+    float maxVelocity() const;
+};
\ No newline at end of file
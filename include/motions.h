@@ -0,0 +1,137 @@
+#pragma once
+#include "lemlib/chassis/chassis.hpp"
+#include "path.h"
+#include "trajectory.h"
+
+class MotionQueue;
+
+/** @brief A motion waiting in the MotionQueue. */
+struct Motion {
+    enum class Type : uint8_t {
+        MOVE_TO_POINT,
+        MOVE_TO_POSE,
+        TURN_TO_HEADING,
+        TURN_TO_POINT,
+        FOLLOW,
+        TRAJECTORY
+    };
+    Type type;
+    /** number of the motion, for its MotionHandle */
+    uint32_t id;
+    /** whether to drive to the point or along the path with the front */
+    bool forwards;
+    /** which way to turn to the heading */
+    lemlib::AngularDirection direction;
+    /** point to move or turn to, in inches */
+    float x;
+    float y;
+    /** heading to turn to, or to end a move to a pose facing, in degrees */
+    float theta;
+    /**
+     * how far before the pose a move to a pose aims, as a fraction of the
+     * distance to it. See lemlib::MoveToPoseParams::lead
+     */
+    float lead;
+    /** fastest the robot can go, 0-127 */
+    float maxSpeed;
+    /** slowest the robot can end the motion at, 0-127 */
+    float minSpeed;
+    /**
+     * inches or degrees from the target at which a motion that doesn't stop
+     * ends, 0 for the config's blend distance or angle
+     */
+    float earlyExitRange;
+    /** path to follow, only a view into its asset */
+    Path path;
+    /** lookahead distance along the path, in inches */
+    float lookahead;
+    /** most the path's speed can change per step, 0 for no limit */
+    float slew;
+    /** trajectory to track, only a view into its asset */
+    Trajectory trajectory;
+    /** ms the motion can take */
+    uint32_t timeout;
+};
+
+/**
+ * @brief A motion being driven by the MotionQueue's task. start() is called
+ * right before the first step(), then step() every period until it returns
+ * false or the motion times out or is cleared, then done().
+ */
+class MotionState {
+  public:
+    virtual ~MotionState() = default;
+    virtual void start() {}
+    /**
+     * @brief Sets the speeds the queue sends to the drivetrain this period
+     * @param dt seconds since the last step, as measured
+     * @return false once the motion has ended
+     */
+    virtual bool step(float dt) = 0;
+    virtual void done() {}
+    /** @return how much of the motion is done as of the last step, 0-1 */
+    virtual float progress() const = 0;
+};
+
+/** @brief A move to a point, or to a pose with a boomerang carrot point */
+class MoveToPointMotion : public MotionState {
+  public:
+    MoveToPointMotion(MotionQueue& queue, const Motion& motion);
+    void start() override;
+    bool step(float dt) override;
+    float progress() const override;
+  private:
+    MotionQueue& m_queue;
+    const Motion m_motion;
+    /** inches from the point, at the start and as of the last step */
+    float m_startDistance = 0;
+    float m_distance = 0;
+};
+
+/** @brief A turn to a heading, or to face a point */
+class TurnToHeadingMotion : public MotionState {
+  public:
+    TurnToHeadingMotion(MotionQueue& queue, const Motion& motion);
+    void start() override;
+    bool step(float dt) override;
+    float progress() const override;
+  private:
+    MotionQueue& m_queue;
+    const Motion m_motion;
+    lemlib::AngularDirection m_direction;
+    /** @return heading to turn to from pose, in radians */
+    float target(const lemlib::Pose& pose) const;
+    /** radians from the heading, at the start and as of the last step */
+    float m_startError = 0;
+    float m_error = 0;
+};
+
+/** @brief Pure pursuit along a compiled Path, see Robot::follow */
+class FollowMotion : public MotionState {
+  public:
+    FollowMotion(MotionQueue& queue, const Motion& motion);
+    void start() override;
+    bool step(float dt) override;
+    float progress() const override;
+  private:
+    MotionQueue& m_queue;
+    const Motion m_motion;
+    PathIndex m_index;
+    float m_prevVel = 0;
+};
+
+/**
+ * @brief RAMSETE tracking of a Trajectory by time, see
+ * MotionQueue::follow(const Trajectory&, int)
+ */
+class TrajectoryMotion : public MotionState {
+  public:
+    TrajectoryMotion(MotionQueue& queue, const Motion& motion);
+    bool step(float dt) override;
+    float progress() const override;
+  private:
+    MotionQueue& m_queue;
+    const Motion m_motion;
+    /** seconds since the motion started */
+    float m_elapsed = 0;
+};
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+#include "config.h"
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/pose.hpp"
+#include "pros/rtos.hpp"
+#include "subsystems/snapshot.h"
+
+/**
+ * @brief Tracks the position of the robot in its own task, integrating every
+ * SensorSnapshot as soon as it's published. The pose is published to lemlib,
+ * so lemlib's motions and Robot::follow use it.
+ *
+ * Replaces lemlib's own tracking task, so lemlib::Chassis::calibrate() should
+ * not be called.
+ */
+class Odometry {
+  public:
+    Odometry(SensorSampler& sampler, lemlib::OdomSensors& odomSensors,
+             RobotConfig::Sensors& sensors);
+
+    /**
+     * @brief Calibrates the IMU, resets the tracking wheels, sets the data rate
+     * of the sensors to the sampler's period and starts the odometry task.
+     * Blocks while the IMU calibrates.
+     */
+    void calibrate();
+
+    /** @returns pose of the robot, with theta in degrees unless radians */
+    lemlib::Pose getPose(bool radians = false);
+    /** @brief Sets the pose of the robot, theta in degrees unless radians */
+    void setPose(lemlib::Pose pose, bool radians = false);
+    /**
+     * @returns velocity of the robot in inches/s, with theta in degrees/s
+     * unless radians
+     */
+    lemlib::Pose getVelocity(bool radians = false);
+    /** @returns when the sensors of the last update were read, in us */
+    uint64_t getTimestamp();
+  private:
+    /** @brief Integrates the change since the last snapshot */
+    void update(const SensorSnapshot& snapshot);
+
+    SensorSampler& m_sampler;
+    lemlib::OdomSensors& m_odomSensors;
+    RobotConfig::Sensors& m_sensors;
+    pros::Task* m_task = nullptr;
+    /** @brief guards m_pose, m_velocity and m_timestamp */
+    pros::Mutex m_mutex;
+
+    /** theta is in radians */
+    lemlib::Pose m_pose {0, 0, 0};
+    /** theta is in radians/s */
+    lemlib::Pose m_velocity {0, 0, 0};
+    uint64_t m_timestamp = 0;
+
+    /** snapshots taken before this time predate the last calibration */
+    uint64_t m_calibratedAt = 0;
+    /** set once the first snapshot after calibrating has been seen */
+    bool m_primed = false;
+    uint32_t m_lastSequence = 0;
+    float m_prevVertical = 0;
+    float m_prevHorizontal = 0;
+    float m_prevImu = 0;
+};
\ No newline at end of file
@@ -0,0 +1,133 @@
+#pragma once
+#include "lemlib/asset.hpp"
+#include "lemlib/pose.hpp"
+#include <cstdint>
+
+/**
+ * @brief Header of a compiled path asset. It is followed by five float arrays
+ * of PathHeader::count elements each: x, y, speed, curvature and distance.
+ * Then four float arrays with one element per segment (count - 1): the
+ * segments' bounding boxes as min x, min y, max x and max y.
+ *
+ * Paths are compiled from JerryIO's LemLib export by host/tools/compilePath,
+ * see `make -C host paths`.
+ */
+struct PathHeader {
+    /** always Path::MAGIC */
+    char magic[4];
+    /** format version, must match Path::VERSION */
+    uint16_t version;
+    /** size of the header in bytes, the arrays start right after it */
+    uint16_t headerSize;
+    /** number of points in the path */
+    uint32_t count;
+    uint32_t reserved;
+};
+
+/**
+ * @brief A compiled path, read straight out of its asset without parsing or
+ * copying.
+ *
+ * Points are in inches, speed is in motor units (-127 to 127), curvature is in
+ * 1/inches, positive when the path curves clockwise, and distance is the arc
+ * length from the start of the path in inches. Segment i goes from point i to
+ * point i + 1.
+ */
+class Path {
+  public:
+    static constexpr char MAGIC[4] = {'P', 'A', 'T', 'H'};
+    static constexpr uint16_t VERSION = 2;
+
+    /** @brief size of a compiled path with count points, in bytes */
+    static constexpr uint32_t assetSize(uint32_t count) {
+      return sizeof(PathHeader) + (5 * count + 4 * (count - 1)) * sizeof(float);
+    }
+
+    /**
+     * @brief Checks the header of the asset. If the asset isn't a compiled
+     * path of the current version, an error is printed and the path is empty.
+     */
+    explicit Path(const asset& data);
+    /** @brief An empty path, which isn't valid */
+    Path() = default;
+
+    /** @returns whether the asset is a valid compiled path */
+    bool isValid() const;
+    /** @returns number of points in the path */
+    uint32_t size() const;
+
+    float x(uint32_t i) const { return m_x[i]; }
+    float y(uint32_t i) const { return m_y[i]; }
+    float speed(uint32_t i) const { return m_speed[i]; }
+    float curvature(uint32_t i) const { return m_curvature[i]; }
+    float distance(uint32_t i) const { return m_distance[i]; }
+    lemlib::Pose point(uint32_t i) const { return {m_x[i], m_y[i]}; }
+
+    /** @returns the bounding box of segment i */
+    float minX(uint32_t i) const { return m_minX[i]; }
+    float minY(uint32_t i) const { return m_minY[i]; }
+    float maxX(uint32_t i) const { return m_maxX[i]; }
+    float maxY(uint32_t i) const { return m_maxY[i]; }
+  private:
+    uint32_t m_count = 0;
+    const float* m_x = nullptr;
+    const float* m_y = nullptr;
+    const float* m_speed = nullptr;
+    const float* m_curvature = nullptr;
+    const float* m_distance = nullptr;
+    const float* m_minX = nullptr;
+    const float* m_minY = nullptr;
+    const float* m_maxX = nullptr;
+    const float* m_maxY = nullptr;
+};
+
+/**
+ * @brief Tracks the robot's progress along a Path for pure pursuit.
+ *
+ * Both searches resume from where the last one ended and only look a bounded
+ * distance ahead, so each update costs the same no matter how long or dense
+ * the path is. Progress along the path never goes backwards.
+ */
+class PathIndex {
+  public:
+    /**
+     * @brief most segments either search looks at in one update, in case the
+     * path is much denser than the lookahead distance
+     */
+    static constexpr uint32_t MAX_WINDOW = 64;
+
+    /** @param lookahead the lookahead distance, in inches */
+    PathIndex(const Path& path, float lookahead);
+
+    /**
+     * @brief Moves the closest point forwards to the point nearest pose. Only
+     * looks as far as one lookahead distance of path ahead of the last
+     * closest point, since the robot can't have passed the lookahead point.
+     *
+     * @return index of the closest point
+     */
+    uint32_t updateClosest(const lemlib::Pose& pose);
+
+    /**
+     * @brief Finds the first point after the closest point and the last
+     * lookahead point where the path leaves the lookahead circle around pose.
+     * Segments whose bounding box is entirely inside or outside the circle are
+     * skipped without solving for the intersection.
+     *
+     * @return the lookahead point, or the last one if the path doesn't leave
+     * the circle within the search window
+     */
+    lemlib::Pose updateLookahead(const lemlib::Pose& pose);
+
+    /** @returns index of the closest point */
+    uint32_t closest() const;
+    /** @returns arc length of the path up to the closest point, in inches */
+    float progress() const;
+  private:
+    const Path& m_path;
+    const float m_lookahead;
+    uint32_t m_closest = 0;
+    /** segment the last lookahead point is on */
+    uint32_t m_lookaheadSegment = 0;
+    lemlib::Pose m_lastLookahead;
+};
\ No newline at end of file
@@ -1,7 +1,14 @@
 #pragma once
 #include "config.h"
+#include "led.h"
+#include "motionQueue.h"
+#include "odometry.h"
+#include "path.h"
+#include "subsystems/input.h"
 #include "subsystems/intake.h"
 #include "subsystems/lift.h"
+#include "subsystems/telemetryStream.h"
+#include "trajectory.h"
 
 /**
  * @brief Provides an abstracted interface for controlling the robot and reading
@@ -16,9 +23,17 @@ class Robot : public lemlib::Chassis {
 
     const RobotConfig& m_config;
 
+    SensorSampler m_sampler;
+    RingDetector m_ringDetector;
+    Input m_input;
     MogoClamp m_mogo;
     Intake m_intake;
     Lift m_lift;
+    Odometry m_odom;
+    MotionQueue m_motions;
+    TelemetryStream m_telemetry;
+    LedStrip m_leftUnderGlow;
+    LedStrip m_rightUnderGlow;
   public:
     /**
      * @brief Gets the robot instance.
@@ -27,9 +42,54 @@ class Robot : public lemlib::Chassis {
      */
     inline static Robot& get() { return instance; };
 
+    SensorSampler& sampler;
+    RingDetector& ringDetector;
+    Input& input;
     Lift& lift;
     Intake& intake;
     MogoClamp& mogo;
+    Odometry& odom;
+    /** chained motions that blend into each other, see MotionQueue */
+    MotionQueue& motions;
+    LedStrip& leftUnderGlow;
+    LedStrip& rightUnderGlow;
+
+    using lemlib::Chassis::follow;
+    /**
+     * @brief Follows a compiled path with pure pursuit. Same as
+     * lemlib::Chassis::follow, but doesn't parse the path at the start, and
+     * is queued on motions, after whatever is already queued there.
+     *
+     * @param path the compiled path, ex. Path {example_path}
+     * @param lookahead the lookahead distance, in inches
+     * @param timeout the maximum time the robot can spend moving
+     * @param forwards whether the robot should follow the path going forwards
+     * @param async whether to return without waiting for the motion to end
+     * @return a handle to the motion, false if it couldn't be queued
+     */
+    MotionHandle follow(const Path& path, float lookahead, int timeout,
+                        bool forwards = true, bool async = true);
+    /**
+     * @brief Tracks a trajectory by time with RAMSETE, queued on motions.
+     * See MotionQueue::follow(const Trajectory&, int).
+     *
+     * @param trajectory the generated trajectory, ex. Trajectory
+     * {example_traj}
+     * @param timeout the maximum time the robot can spend moving
+     * @param async whether to return without waiting for the motion to end
+     * @return a handle to the motion, false if it couldn't be queued
+     */
+    MotionHandle follow(const Trajectory& trajectory, int timeout,
+                        bool async = true);
+
+    /**
+     * @brief Sets the pose of the robot through odom. Hides
+     * lemlib::Chassis::setPose, which only sets lemlib's copy of the pose,
+     * so it would be overwritten by the next odometry update.
+     */
+    void setPose(float x, float y, float theta, bool radians = false);
+    /** @copydoc setPose(float, float, float, bool) */
+    void setPose(lemlib::Pose pose, bool radians = false);
 };
 
 inline Robot& bot = Robot::get();
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+#include "doubleBuffer.h"
+#include "pros/rtos.hpp"
+#include <array>
+#include <atomic>
+#include <initializer_list>
+
+/**
+ * @brief Owns the brain screen. Tasks publish values into named slots, and
+ * the screen task formats each line from its slots and redraws it only if its
+ * text changed, at most once per Config::period. Nothing else should print to
+ * the screen. Follows the Singleton pattern.
+ */
+class Screen {
+  public:
+    static constexpr int LINES = 8;
+    static constexpr uint32_t LINE_LENGTH = 64;
+    static constexpr uint32_t MAX_SLOTS = 32;
+    /** @brief most slots one line can show */
+    static constexpr uint32_t MAX_LINE_SLOTS = 4;
+
+    struct Config {
+        /** ms between redraws, no faster than the screen refreshes */
+        uint32_t period;
+
+        /** default config */
+        static Config config;
+    };
+
+    /** @brief A value shown on the screen. Safe to set from any task. */
+    class Slot {
+      public:
+        void set(float value) {
+          m_value.store(value, std::memory_order_relaxed);
+        }
+        float get() const { return m_value.load(std::memory_order_relaxed); }
+      private:
+        friend class Screen;
+        const char* m_name = nullptr;
+        std::atomic<float> m_value = 0;
+    };
+
+    /**
+     * @brief Gets the Screen instance.
+     * If it has not been previously constructed (instance == nullptr), then
+     * this method will construct it.
+     */
+    static Screen* get();
+
+    /**
+     * @brief Gets the slot called name, adding it if there isn't one. Meant
+     * to be called once, with the slot kept for publishing.
+     *
+     * @param name a string that outlives the screen, ex. "lift.angle"
+     */
+    Slot& slot(const char* name);
+
+    /**
+     * @brief Shows format on line, with the values of slots substituted in
+     * order.
+     *
+     * @param format fmt format string, ex. "angle: {:.2f}". Must outlive the
+     * screen.
+     * @param slots names of up to MAX_LINE_SLOTS slots
+     */
+    void setLine(int line, const char* format,
+                 std::initializer_list<const char*> slots = {});
+
+    /**
+     * @brief Shows text on a line that has no format from setLine(). Only one
+     * task should set the text of a line.
+     */
+    void setText(int line, const char* text);
+
+    /** @return how many times a line has been redrawn */
+    uint32_t getRedraws() const;
+  private:
+    using Text = std::array<char, LINE_LENGTH>;
+
+    struct Line {
+        /** null if the line shows text from setText() */
+        const char* format = nullptr;
+        Slot* slots[MAX_LINE_SLOTS] {};
+        DoubleBuffer<Text> text;
+        /** what's on the screen now */
+        Text drawn {};
+    };
+
+    const Config& m_config;
+    /** @brief guards m_slots and the formats, held by the task while drawing */
+    pros::Mutex m_mutex;
+    std::array<Slot, MAX_SLOTS> m_slots;
+    uint32_t m_slotCount = 0;
+    /** @brief given out when every slot is taken */
+    Slot m_spareSlot;
+    std::array<Line, LINES> m_lines;
+    std::atomic<uint32_t> m_redraws = 0;
+    pros::Task m_task;
+
+    /** @brief redraws every line whose text changed */
+    void draw();
+
+    /** @brief starts the screen task */
+    Screen(const Config& config);
+    /**
+     * @brief Should ever be one instance of Screen, and that's this one.
+     */
+    static Screen* instance;
+};
\ No newline at end of file
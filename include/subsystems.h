@@ -1,32 +1,100 @@
 #include "pros/rtos.hpp"
-#include <map>
+#include <atomic>
+#include <cstdint>
+#include <vector>
 
 #pragma once
 
+/** @brief Timing of a Subsystem's updates, recorded by the SubsystemHandler. */
+struct SubsystemStats {
+    /** number of times update() has been called */
+    uint32_t updates = 0;
+    /** execution time of the last update() in microseconds */
+    uint32_t lastExecTime = 0;
+    /** longest execution time of update() in microseconds */
+    uint32_t maxExecTime = 0;
+    /** sum of every execution time of update() in microseconds */
+    uint64_t totalExecTime = 0;
+    /** how late the last update() started, in microseconds */
+    uint32_t lastJitter = 0;
+    /** how late the latest update() has ever started, in microseconds */
+    uint32_t maxJitter = 0;
+    /** number of periods in which update() could not be called on time */
+    uint32_t missedDeadlines = 0;
+};
+
 /**
  * @brief A Subsystem should provides an abstracted interface for controlling
  * said subsystem.
  * If needed, an update method can be written that will be ran
- * every 10ms by the SubsystemHandler.
+ * every period by the SubsystemHandler.
  */
 class Subsystem {
+  public:
+    /** @brief period of a Subsystem that is only updated by requestUpdate() */
+    static constexpr uint32_t EVENT_DRIVEN = 0;
+    /** @brief period used by Subsystems that don't declare their own */
+    static constexpr uint32_t DEFAULT_PERIOD = 10;
+
+    /**
+     * @brief Determines the order in which Subsystems are updated within a
+     * tick, so that controllers see this tick's sensor readings and actuators
+     * see this tick's outputs.
+     */
+    enum class Stage {
+      /** reads sensors */
+      SENSOR,
+      /** reads sensors and/or the sensor stage, then commands actuators */
+      CONTROLLER,
+      /** only drives actuators */
+      ACTUATOR,
+    };
   private:
+    friend class SubsystemHandler;
+
+    /** @brief ms between updates, or EVENT_DRIVEN */
+    const uint32_t m_period;
+    const Stage m_stage;
+    /** @brief when the next update is due, in microseconds */
+    uint64_t m_nextUpdate = 0;
+    /** @brief set by requestUpdate(), cleared once the update has run */
+    std::atomic<bool> m_updateRequested = false;
+    SubsystemStats m_stats;
+
     /** @brief id for this Subsystem, determined by the SubsystemHandler. */
     const int m_id;
   protected:
-    /** @brief Automatically adds this Subsystem to the SubsystemHandle. */
-    Subsystem();
+    /**
+     * @brief Automatically adds this Subsystem to the SubsystemHandle.
+     *
+     * @param period ms between calls to update(), or EVENT_DRIVEN
+     * @param stage when this Subsystem is updated relative to the others
+     */
+    Subsystem(uint32_t period = DEFAULT_PERIOD,
+              Stage stage = Stage::CONTROLLER);
+
+    /**
+     * @brief Asks the SubsystemHandler to call update() as soon as possible,
+     * regardless of the period. Safe to call from any task.
+     */
+    void requestUpdate();
   public:
-    /** @brief Is run every 10ms by the SubsystemHandler. */
+    /** @brief Is run every period by the SubsystemHandler. */
     virtual void update() = 0;
 
+    /** @returns ms between updates, or EVENT_DRIVEN */
+    uint32_t getPeriod() const;
+    Stage getStage() const;
+    /** @returns timing of this Subsystem's updates so far */
+    const SubsystemStats& getStats() const;
+
     /** @brief Removes this Subsystem from the SubsystemHandler. As it should
      * never be called, it will create a log message. */
     virtual ~Subsystem();
 };
 
 /**
- * @brief Handles Subsystems, calling their update() method every 10ms.
+ * @brief Handles Subsystems, calling their update() method every period.
  * Follows the Singleton pattern
  */
 class SubsystemHandler {
@@ -39,8 +107,9 @@ class SubsystemHandler {
     static SubsystemHandler* get();
 
     /**
-     * @brief Adds subsystem to SubsystemHandler's vector, causing it to be
-     * updated every 10ms.
+     * @brief Adds subsystem to SubsystemHandler's registry, causing it to be
+     * updated every period, after every Subsystem of an earlier Stage. Safe to
+     * call from any task.
      *
      * @return int Id for the subsystem which can be used to remove it from the
      * SubsystemHandler.
@@ -48,22 +117,66 @@ class SubsystemHandler {
     int addSubsystem(Subsystem* subsystem);
 
     /**
-     * @brief Removes the subsytem from the SubsystemHandler's vector,
-     * preventing it from being updated every 10ms.
+     * @brief Removes the subsytem from the SubsystemHandler's registry,
+     * preventing it from being updated. Safe to call from any task. Once this
+     * returns, the handler is guaranteed to be done with the subsystem.
      *
      * @param subsystemId the id returned from addSubsystem.
      */
     void removeSubsystem(int subsystemId);
+
+    /** @brief Wakes the handler task so that requested updates run now. */
+    void wake();
   private:
+    struct Entry {
+        int id;
+        Subsystem* subsystem;
+    };
+
+    /**
+     * @brief An immutable list of Subsystems, in the order they are updated.
+     * Changes to the registry publish a new Registry instead of modifying the
+     * one that the handler task may be walking.
+     */
+    struct Registry {
+        std::vector<Entry> entries;
+        /** next Registry waiting to be freed */
+        Registry* nextRetired = nullptr;
+    };
+
     /** @brief the last id used to add a Subsystem. */
     int m_lastUsedId;
-    /** @brief map of id to Subsystem. */
-    std::unordered_map<int, Subsystem*> m_subsystems;
-    /** @brief the task responsible for updating m_subsystems every 10ms. */
+    /** @brief the current registry, only ever replaced as a whole */
+    std::atomic<Registry*> m_registry;
+    /**
+     * @brief registries that have been replaced. The handler task is their
+     * only reader, so it frees them between updates.
+     */
+    std::atomic<Registry*> m_retired;
+    /** @brief serializes changes to the registry, never taken by the task */
+    pros::Mutex m_writeMutex;
+    /** @brief set while the handler task is walking a registry */
+    std::atomic<bool> m_updating;
+    /** @brief number of times the handler task has finished walking */
+    std::atomic<uint32_t> m_passes;
+    /** @brief the task responsible for updating the registry. */
     pros::Task m_task;
 
-    /** @brief updates each of the m_subsystems. */
-    void update();
+    /**
+     * @brief updates each of the registered Subsystems that are due or have
+     * requested an update, recording their timing.
+     *
+     * @return when the next update is due, in microseconds
+     */
+    uint64_t update();
+
+    /**
+     * @brief Publishes a modified copy of the current registry. Requires
+     * m_writeMutex.
+     */
+    void publish(Registry* registry);
+    /** @brief Frees every retired registry. Only called by the task. */
+    void reclaim();
 
     /** @brief starts the handler task */
     SubsystemHandler();
@@ -0,0 +1,148 @@
+#pragma once
+#include "byteRing.h"
+#include "doubleBuffer.h"
+#include "pros/misc.hpp"
+#include "subsystems.h"
+#include <atomic>
+#include <cstddef>
+
+/** @brief Every button and axis of the controller, read in one pass. */
+struct ControllerState {
+    /** number of buttons, L1 through A */
+    static constexpr uint32_t BUTTONS = 12;
+
+    /** when the controller was read, in microseconds */
+    uint64_t timestamp = 0;
+    /** bit n is set while button E_CONTROLLER_DIGITAL_L1 + n is held */
+    uint16_t buttons = 0;
+    /** indexed by pros::controller_analog_e_t, -127 to 127 */
+    int8_t axes[4] = {};
+
+    static constexpr uint32_t index(pros::controller_digital_e_t button) {
+      return button - pros::E_CONTROLLER_DIGITAL_L1;
+    }
+
+    bool held(pros::controller_digital_e_t button) const {
+      return buttons >> index(button) & 1;
+    }
+
+    int32_t axis(pros::controller_analog_e_t channel) const {
+      return axes[channel];
+    }
+};
+
+/** @brief A button changing, as seen by Input. */
+struct InputEvent {
+    enum Type : uint8_t {
+      PRESS,
+      RELEASE,
+      /** the button has been held for Input::Config::holdTime */
+      HOLD,
+      TYPES
+    };
+    Type type;
+    pros::controller_digital_e_t button;
+    /** when the controller read that saw it was taken, in microseconds */
+    uint64_t timestamp;
+};
+
+/**
+ * @brief What to do for each event of each button, and for every read of the
+ * controller. Built at compile time, see makeBindings(), so dispatching an
+ * event is a single lookup.
+ */
+struct Bindings {
+    using Action = void (*)(const ControllerState& state);
+    struct Binding {
+        pros::controller_digital_e_t button;
+        InputEvent::Type type;
+        Action action;
+    };
+
+    /** called with every read of the controller, for the sticks */
+    Action everyRead = nullptr;
+    Action actions[ControllerState::BUTTONS][InputEvent::TYPES] = {};
+};
+
+/**
+ * @return whether no event is bound twice in list, to static_assert before
+ * makeBindings()
+ */
+template <size_t N>
+constexpr bool bindsEachOnce(const Bindings::Binding (&list)[N]) {
+  for (size_t i = 0; i < N; ++i)
+    for (size_t j = 0; j < i; ++j)
+      if (list[i].button == list[j].button && list[i].type == list[j].type)
+        return false;
+  return true;
+}
+
+/**
+ * @brief Builds the table for Input::bind(). A later binding of an event
+ * replaces an earlier one, so check the list with bindsEachOnce() first.
+ */
+template <size_t N>
+constexpr Bindings makeBindings(Bindings::Action everyRead,
+                                const Bindings::Binding (&list)[N]) {
+  Bindings bindings;
+  bindings.everyRead = everyRead;
+  for (const Bindings::Binding& binding : list)
+    bindings.actions[ControllerState::index(binding.button)][binding.type] =
+        binding.action;
+  return bindings;
+}
+
+/**
+ * @brief Reads the whole controller once per update, before any other stage,
+ * and queues an InputEvent for every press, release and hold since the last
+ * read. The events are dispatched through the bound Bindings in the same
+ * update, so the subsystems they command see them in the same tick.
+ *
+ * Nothing is dispatched during autonomous or while disabled.
+ */
+class Input : public Subsystem {
+  public:
+    /** @brief most events that can be waiting to be dispatched */
+    static constexpr uint32_t QUEUE_SIZE = 512;
+
+    struct Config {
+        /** ms between reads of the controller */
+        uint32_t period;
+        /** ms a button has to be held before a HOLD event */
+        uint32_t holdTime;
+
+        /** default config */
+        static Config config;
+    };
+
+    Input(pros::controller_id_e_t id, const Config& config);
+
+    void update() override;
+
+    /**
+     * @brief Dispatches events through bindings from the next update on,
+     * nullptr to stop. bindings has to outlive its use, so should be static.
+     */
+    void bind(const Bindings* bindings);
+
+    /**
+     * @return the state of the controller as of the last update. Safe to
+     * call from any task.
+     */
+    ControllerState getState() const;
+  private:
+    pros::Controller m_controller;
+    const Config& m_config;
+    std::atomic<const Bindings*> m_bindings = nullptr;
+
+    ControllerState m_state;
+    DoubleBuffer<ControllerState> m_published;
+    /** when each held button was pressed, in microseconds */
+    uint64_t m_pressedAt[ControllerState::BUTTONS] = {};
+    /** bit n is set once button n has had its HOLD event */
+    uint16_t m_holdSent = 0;
+
+    ByteRing<QUEUE_SIZE> m_events;
+
+    void push(InputEvent::Type type, uint32_t button, uint64_t timestamp);
+};
\ No newline at end of file
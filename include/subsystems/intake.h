@@ -2,17 +2,87 @@
 #include "pros/motor_group.hpp"
 #include "pros/optical.hpp"
 #include "subsystems/mogo.h"
+#include "subsystems/ringDetector.h"
+#include "subsystems/snapshot.h"
+#include <atomic>
 
 class Intake : public Subsystem {
   public:
     enum State { IN, OUT, IDLE, IN_TO_LIFT, OUT_TO_LIFT };
+
+    struct Config {
+        /** ms between updates, as often as the RingDetector for its events */
+        uint32_t updatePeriod;
+        /**
+         * ms after a ring enters the optical sensor's view before the intake
+         * reverses to hook it onto the lift
+         */
+        uint32_t liftLoadDelay;
+        /**
+         * most ms the intake reverses for to hook a ring onto the lift, it
+         * stops once the ring has backed off the sensor
+         */
+        uint32_t liftReverseTime;
+
+        /** rings of this color are thrown out of the top, NONE to not sort */
+        RingColor sortColor;
+        /**
+         * intake motor degrees from where the optical sensor first sees a
+         * ring to the top, where the ring is thrown off if the chain stops
+         * suddenly
+         */
+        float ejectDistance;
+        /**
+         * intake motor degrees a ring stays in view of the optical sensor.
+         * Rings of the same color touching look like one long ring
+         */
+        float ringViewDistance;
+        /** ms the intake takes to respond, the pulse starts this early */
+        uint32_t ejectLead;
+        /**
+         * ms the intake is driven in reverse for to throw a ring off. Short
+         * enough that the chain stops but doesn't run backwards, which
+         * would hook the ring at the sensor onto a lowered lift
+         */
+        uint32_t ejectPulse;
+
+        /** default config */
+        static Config config;
+    };
   private:
     State m_state = State::IDLE;
     pros::MotorGroup& m_motors;
+    /** only used for its led, readings come from m_sensors */
     pros::Optical& m_optical;
+    const SensorSampler& m_sensors;
+    RingDetector& m_detector;
+    const Config& m_config;
     uint32_t m_switchStateTimestamp = pros::millis();
-    /** if = 0, then we were not sensing the ring */
-    uint32_t m_startSensingRingTimestamp = 0;
+    /** when the ring in view entered it in microseconds, 0 without a ring */
+    uint64_t m_ringEnteredAt = 0;
+
+    /** most rings that can be between the optical sensor and the top */
+    static constexpr uint32_t MAX_EJECTS = 4;
+    std::atomic<RingColor> m_sortColor;
+    /**
+     * intake motor positions at which the rings to be thrown off reach the top,
+     * in the order they'll get there
+     */
+    float m_ejectAt[MAX_EJECTS];
+    uint32_t m_ejectCount = 0;
+    /** intake motor position when the ring in view entered it */
+    float m_viewStart = 0;
+    /** when the current eject pulse ends in ms, 0 if there isn't one */
+    uint32_t m_ejectUntil = 0;
+    uint32_t m_ejected = 0;
+
+    /** @brief Queues a ring to be thrown off once the intake is at position */
+    void scheduleEject(float position);
+    /**
+     * @brief Starts an eject pulse if the next ring to be thrown off will reach
+     * the top by the time the intake has reversed.
+     */
+    void checkEject(float position, float velocity);
   public:
     void setState(State state);
     void stop();
@@ -20,9 +90,17 @@ class Intake : public Subsystem {
     void outtake();
     void intakeToLift();
 
+    /** @brief Throws rings of color out of the top, NONE to stop sorting. */
+    void setSortColor(RingColor color);
+    RingColor getSortColor() const;
+    /** @return how many eject pulses have been started */
+    uint32_t getEjected() const;
+
     void update() override;
 
     const State& getState() const;
 
-    Intake(pros::MotorGroup& motors, pros::Optical& optical);
-};
+    Intake(pros::MotorGroup& motors, pros::Optical& optical,
+           const SensorSampler& sensors, RingDetector& detector,
+           const Config& config);
+};
\ No newline at end of file
@@ -1,11 +1,15 @@
 #pragma once
+#include "armFit.h"
 #include "lemlib/chassis/chassis.hpp"
 #include "lemlib/exitcondition.hpp"
+#include "motionProfile.h"
 #include "pros/motor_group.hpp"
-#include "pros/rotation.hpp"
+#include "screen.h"
 #include "subsystems.h"
+#include "subsystems/snapshot.h"
+#include <atomic>
 
-class Lift : Subsystem {
+class Lift : public Subsystem {
   public:
     enum State {
       /** low enough to pick up ring from mogo */
@@ -16,6 +20,11 @@ class Lift : Subsystem {
       TOP,
       /** brakes motor in case of emergency */
       EMERGENCY_STOP,
+      /**
+       * sweeps the lift up and down to fit its feedforward, see
+       * characterize()
+       */
+      CHARACTERIZE,
     };
 
     struct Config {
@@ -30,6 +39,32 @@ class Lift : Subsystem {
         float top;
         /** gear ratio of lift : rotation sensor */
         float gearRatio;
+        /** ms between updates of the lift's controller */
+        uint32_t updatePeriod;
+
+        /** limits of the lift's moves, in degrees and seconds */
+        ProfileConstraints profile;
+        /** angle of the lift when it's parallel to the ground */
+        float horizontal;
+        /** feedforward, mV to hold the empty lift up when it's horizontal */
+        float kG;
+        /** feedforward, mV to overcome friction while moving */
+        float kS;
+        /** feedforward, mV per degree/s */
+        float kV;
+        /** feedforward, mV per degree/s^2 */
+        float kA;
+        /**
+         * mV/s added to the load estimate per degree of error while holding,
+         * 0 to not estimate the load of rings on the lift
+         */
+        float loadGain;
+        /** most mV the load estimate can add to kG */
+        float maxLoad;
+        /** mV/s the voltage ramps at while characterizing */
+        float sweepRate;
+        /** samples of the sweep accelerating faster than this are left out */
+        float sweepMaxAcceleration;
 
         /** controller settings for lift */
         lemlib::ControllerSettings controllerSettings;
@@ -41,7 +76,42 @@ class Lift : Subsystem {
     State m_state;
     Config& m_config;
     pros::MotorGroup& m_motors;
-    pros::Rotation& m_rotation;
+    const SensorSampler& m_sensors;
+
+    /** last voltage sent to the motors, 0 while braking */
+    float m_output = 0;
+    /**
+     * mV needed to hold the lift up at horizontal on top of kG, learned while
+     * holding, from the rings on the lift
+     */
+    float m_load = 0;
+
+    /** moves between BOTTOM, MIDDLE and TOP, indexed by [from][to] */
+    MotionProfile m_profiles[3][3];
+    /** move from wherever the lift was when a move was interrupted */
+    MotionProfile m_interruptedProfile;
+    /** the move being followed, null if there isn't one */
+    const MotionProfile* m_profile = nullptr;
+    /** when m_profile started, in ms */
+    uint32_t m_profileStart = 0;
+    /** state the lift was last moved to by update() */
+    State m_lastState;
+    /** set by setState() so that update(), on its own task, starts a move */
+    std::atomic<bool> m_stateChanged = false;
+
+    /** samples of the sweep while characterizing */
+    ArmFit m_fit;
+    /** true while the sweep is going up */
+    bool m_sweepUp = true;
+    /** voltage the current direction of the sweep started at, in mV */
+    float m_sweepStartVoltage = 0;
+    /** velocity at the last step of the sweep, in degrees/s */
+    float m_sweepVelocity = 0;
+
+    /** published to the screen every update */
+    Screen::Slot& m_targetSlot;
+    Screen::Slot& m_angleSlot;
+    Screen::Slot& m_errorSlot;
 
     lemlib::PID m_pid;
     /** small exit condition */
@@ -54,10 +124,21 @@ class Lift : Subsystem {
     float getTargetAngle() const;
     /** @returns Current angle of the lift in degrees. */
     float calcLiftAngle() const;
+    /** @returns Current velocity of the lift in degrees/s. */
+    float calcLiftVelocity() const;
     /** @returns Error between current lift angle and target lift angle.  */
     float calcError() const;
+    /** @returns The target lift angle of state, NaN for EMERGENCY_STOP. */
+    float getTargetAngle(State state) const;
+    /** @brief Starts following a move to m_state. Only called by update(). */
+    void startMove();
+    /** @brief Steps the characterization sweep. Only called by update(). */
+    void sweep();
+    /** @returns Last voltage sent to the motors in mV, 0 while braking. */
+    float getOutput() const;
   public:
-    Lift(pros::MotorGroup& motors, pros::Rotation& rotation, Config& config);
+    Lift(pros::MotorGroup& motors, const SensorSampler& sensors,
+         Config& config);
 
     void update() override;
 
@@ -65,6 +146,13 @@ class Lift : Subsystem {
     void setState(State state);
 
     void emergencyStop();
+    /**
+     * Slowly ramps the voltage up until the lift reaches the top, then down
+     * until it reaches the bottom, fitting kG, horizontal, kS and kV from the
+     * sweep. Logs the fit gains at info level and shows them on the screen,
+     * then goes to the bottom. Don't run it with a ring on the lift.
+     */
+    void characterize();
     void goToBottom();
     void goToMiddle();
     void goToTop();
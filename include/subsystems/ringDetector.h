@@ -0,0 +1,114 @@
+#pragma once
+#include "byteRing.h"
+#include "subsystems.h"
+#include "subsystems/snapshot.h"
+
+enum class RingColor : uint8_t { NONE, RED, BLUE };
+
+/** @brief A ring coming into or going out of view of the intake optical. */
+struct RingEvent {
+    enum class Type : uint8_t { ENTERED, LEFT };
+    Type type;
+    /** color of the ring from its hue, NONE if it's neither red nor blue */
+    RingColor color;
+    /**
+     * when the proximity first crossed the threshold, before debouncing, in
+     * microseconds from the snapshot
+     */
+    uint64_t timestamp;
+    /**
+     * color of the ring, in degrees and 0-255. When it entered, the reading
+     * that confirmed it, when it left, the average while it was in view
+     */
+    float hue;
+    float red;
+    float green;
+    float blue;
+};
+
+/**
+ * @brief Watches the intake optical sensor in every snapshot, right after the
+ * SensorSampler, and queues a timestamped RingEvent whenever a ring enters or
+ * leaves its view.
+ *
+ * A ring has entered once the proximity has been above enterProximity for
+ * debounce ms, and has left once it has been below leaveProximity for
+ * debounce ms. Rings touching on the chain keep the proximity up, so a
+ * change of color for debounce ms is also a ring leaving and the next one
+ * entering. Events are timestamped with when the proximity or color first
+ * changed, so whoever reads them can tell exactly how far the ring has
+ * travelled since.
+ */
+class RingDetector : public Subsystem {
+  public:
+    /** @brief most events that can be waiting to be polled */
+    static constexpr uint32_t QUEUE_SIZE = 256;
+
+    struct Config {
+        /** ms between updates, the same as the SensorSampler */
+        uint32_t period;
+        /** proximity above which a ring is in view, 0-255 */
+        int32_t enterProximity;
+        /** proximity below which a ring is out of view, 0-255 */
+        int32_t leaveProximity;
+        /** ms the proximity has to stay past a threshold before an event */
+        uint32_t debounce;
+        /** a ring is red if its hue is below redBelow or above redAbove */
+        float redBelow;
+        float redAbove;
+        /** a ring is blue if its hue is between blueAbove and blueBelow */
+        float blueAbove;
+        float blueBelow;
+
+        /** default config */
+        static Config config;
+    };
+
+    RingDetector(const SensorSampler& sensors, const Config& config);
+
+    void update() override;
+
+    /**
+     * @brief Pops the oldest event. Should only be called from one task, the
+     * SubsystemHandler's.
+     *
+     * @return false if there weren't any events
+     */
+    bool poll(RingEvent& event);
+
+    /** @return true if a ring is in view, as of the last event */
+    bool isRingPresent() const;
+
+    /** @return events dropped because nothing polled them */
+    uint32_t getDropped() const;
+
+    /** @return the color of a ring with hue, in degrees */
+    RingColor classify(float hue) const;
+  private:
+    const SensorSampler& m_sensors;
+    const Config& m_config;
+
+    uint32_t m_lastSequence = 0;
+    std::atomic<bool> m_present = false;
+    /** when the proximity crossed the threshold out of m_present, 0 if not */
+    uint64_t m_crossedAt = 0;
+    /** color of the ring in view */
+    RingColor m_color = RingColor::NONE;
+    /** when the ring in view started looking like another color, 0 if not */
+    uint64_t m_recoloredAt = 0;
+
+    /** sums of the readings while the ring is in view, for its average */
+    float m_hueX = 0;
+    float m_hueY = 0;
+    float m_redSum = 0;
+    float m_greenSum = 0;
+    float m_blueSum = 0;
+    uint32_t m_readings = 0;
+
+    ByteRing<QUEUE_SIZE> m_events;
+
+    void entered(const SensorSnapshot& snapshot, uint64_t timestamp);
+    /** @brief Queues the ring in view leaving, with its average color */
+    void left(uint64_t timestamp);
+    void push(const RingEvent& event);
+};
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+#include "config.h"
+#include "doubleBuffer.h"
+#include "lemlib/chassis/chassis.hpp"
+#include "subsystems.h"
+
+/** @brief Every sensor reading the robot code uses, taken at one instant. */
+struct SensorSnapshot {
+    /** when the sensors were read, in microseconds */
+    uint64_t timestamp = 0;
+    /** incremented for every snapshot */
+    uint32_t sequence = 0;
+
+    /** distance traveled by the vertical tracking wheel, in inches */
+    float vertical = 0;
+    /** distance traveled by the horizontal tracking wheel, in inches */
+    float horizontal = 0;
+    /** unbounded rotation of the imu, in degrees */
+    float imuRotation = 0;
+
+    /** angle of the lift rotation sensor, in degrees */
+    float liftAngle = 0;
+    /** velocity of the lift rotation sensor, in degrees/s */
+    float liftVelocity = 0;
+
+    /** proximity from the intake optical sensor, 0-255 */
+    int32_t intakeProximity = 0;
+    /** hue from the intake optical sensor, in degrees */
+    float intakeHue = 0;
+    /** color from the intake optical sensor, read in the same pass as hue */
+    pros::c::optical_rgb_s_t intakeRgb {};
+};
+
+/**
+ * @brief Reads every sensor once per tick, before any other Subsystem updates,
+ * and publishes the readings as a SensorSnapshot. Everything else reads the
+ * snapshot instead of the devices, so each device is read once per tick and
+ * every reader sees the same instant.
+ */
+class SensorSampler : public Subsystem {
+  public:
+    /** @brief most tasks that can be notified of new snapshots */
+    static constexpr uint32_t MAX_LISTENERS = 4;
+
+    struct Config {
+        /** ms between snapshots, at least 5 */
+        uint32_t period;
+
+        /** default config */
+        static Config config;
+    };
+
+    SensorSampler(RobotConfig::Sensors& sensors,
+                  lemlib::OdomSensors& odomSensors, const Config& config);
+
+    void update() override;
+
+    /** @returns the latest snapshot. Safe to call from any task. */
+    SensorSnapshot get() const;
+
+    /**
+     * @brief Notifies task every time a snapshot is published. Should only be
+     * called from one task at a time.
+     */
+    void addListener(pros::task_t task);
+  private:
+    RobotConfig::Sensors& m_sensors;
+    lemlib::OdomSensors& m_odomSensors;
+
+    uint32_t m_sequence = 0;
+    DoubleBuffer<SensorSnapshot> m_buffer;
+
+    pros::task_t m_listeners[MAX_LISTENERS] {};
+    std::atomic<uint32_t> m_listenerCount = 0;
+};
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+#include "odometry.h"
+#include "subsystems.h"
+#include "subsystems/lift.h"
+#include "telemetry.h"
+
+/**
+ * @brief Streams the state of the robot as binary telemetry every period,
+ * after every other Subsystem has updated.
+ */
+class TelemetryStream : public Subsystem {
+  public:
+    struct Config {
+        /** ms between frames, 0 to not stream at all */
+        uint32_t period;
+
+        /** default config */
+        static Config config;
+    };
+
+    TelemetryStream(Odometry& odom, const Lift& lift, const Config& config);
+
+    void update() override;
+  private:
+    Odometry& m_odom;
+    const Lift& m_lift;
+
+    /** x, y in inches and theta in degrees, from odometry */
+    telemetry::Channel<float, float, float> m_pose {
+        1, "pose", {"x", "y", "theta"}};
+    /** target and angle in degrees, output in mV, velocity in degrees/s */
+    telemetry::Channel<float, float, float, float> m_liftChannel {
+        2, "lift", {"target", "angle", "output", "velocity"}};
+};
\ No newline at end of file
@@ -0,0 +1,125 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * Binary telemetry, sent as fixed size frames on stdout alongside the text
+ * log. host/tools/telemetryToCsv.cpp decodes a capture of stdout into CSVs.
+ *
+ * Every frame is
+ *   SYNC[2] | channel (u8) | payload size (u8) | payload | fletcher16 (u16)
+ * with the checksum covering the channel, size and payload. Everything is
+ * little endian.
+ *
+ * Data frames carry a u32 timestamp in ms followed by the channel's fields,
+ * packed. Channel SCHEMA_CHANNEL carries schemas instead:
+ *   channel (u8) | field count (u8) | type codes | channel name \0
+ *   | field names \0 separated
+ * Type codes are those of Python's struct module: f i I h H b B.
+ */
+namespace telemetry {
+constexpr uint8_t SYNC[2] = {0xA5, 0x5A};
+/** @brief channel the schemas of the other channels are sent on */
+constexpr uint8_t SCHEMA_CHANNEL = 0;
+/** @brief bytes in a frame that aren't payload */
+constexpr uint32_t OVERHEAD = 6;
+/** @brief largest payload, so a whole frame fits in one LogBuffer message */
+constexpr uint32_t MAX_PAYLOAD = 250;
+/** @brief ms between repeats of a channel's schema, for late listeners */
+constexpr uint32_t SCHEMA_PERIOD = 1000;
+
+template <typename T> constexpr char typeCode() {
+  if constexpr (std::is_same_v<T, float>) return 'f';
+  else if constexpr (std::is_same_v<T, int32_t>) return 'i';
+  else if constexpr (std::is_same_v<T, uint32_t>) return 'I';
+  else if constexpr (std::is_same_v<T, int16_t>) return 'h';
+  else if constexpr (std::is_same_v<T, uint16_t>) return 'H';
+  else if constexpr (std::is_same_v<T, int8_t>) return 'b';
+  else if constexpr (std::is_same_v<T, uint8_t>) return 'B';
+  else static_assert(!sizeof(T), "unsupported telemetry field type");
+}
+
+inline uint16_t fletcher16(const uint8_t* data, uint32_t size) {
+  uint16_t a = 0, b = 0;
+  for (uint32_t i = 0; i < size; ++i) {
+    a = (a + data[i]) % 255;
+    b = (b + a) % 255;
+  }
+  return b << 8 | a;
+}
+
+/**
+ * @brief Adds the sync bytes and checksum around the payload already at
+ * frame + 4 and sends the frame. Never blocks, the frame is dropped if the
+ * log buffer is full.
+ *
+ * @param frame room for payloadSize + OVERHEAD bytes
+ */
+void send(uint8_t* frame, uint8_t channel, uint8_t payloadSize);
+
+/** @return ms since the program started, the timestamp of data frames */
+uint32_t now();
+
+/**
+ * @brief A stream of frames with the same fields. Sending a frame formats
+ * nothing and allocates nothing, it's a few memcpys into a stack buffer.
+ *
+ * @tparam Fields types of the fields, in the order they're sent
+ */
+template <typename... Fields> class Channel {
+    static constexpr uint32_t PAYLOAD = 4 + (sizeof(Fields) + ... + 0);
+    static_assert(PAYLOAD <= MAX_PAYLOAD, "too many telemetry fields");
+  public:
+    /**
+     * @param id unique id of the channel, not SCHEMA_CHANNEL
+     * @param name name of the channel, used for the CSV filename
+     * @param fieldNames name of each field, used for the CSV header
+     */
+    Channel(uint8_t id, const char* name,
+            const std::array<const char*, sizeof...(Fields)>& fieldNames)
+      : m_id(id), m_name(name), m_fieldNames(fieldNames) {}
+
+    /** @brief Sends a frame. Should only be called from one task. */
+    void send(Fields... values) {
+      const uint32_t time = now();
+      if (!m_schemaSent || time - m_schemaTime >= SCHEMA_PERIOD) {
+        sendSchema();
+        m_schemaSent = true;
+        m_schemaTime = time;
+      }
+      uint8_t frame[PAYLOAD + OVERHEAD];
+      uint8_t* out = frame + 4;
+      std::memcpy(out, &time, sizeof(time));
+      out += sizeof(time);
+      ((std::memcpy(out, &values, sizeof(values)), out += sizeof(values)),
+       ...);
+      telemetry::send(frame, m_id, PAYLOAD);
+    }
+  private:
+    void sendSchema() {
+      uint8_t frame[MAX_PAYLOAD + OVERHEAD];
+      uint8_t* const payload = frame + 4;
+      uint32_t size = 0;
+      const auto append = [&](const void* data, uint32_t length) {
+        length = std::min(length, MAX_PAYLOAD - size);
+        std::memcpy(payload + size, data, length);
+        size += length;
+      };
+      const uint8_t header[] = {m_id, sizeof...(Fields), typeCode<Fields>()...};
+      append(header, sizeof(header));
+      append(m_name, std::strlen(m_name) + 1);
+      for (const char* fieldName : m_fieldNames)
+        append(fieldName, std::strlen(fieldName) + 1);
+      telemetry::send(frame, SCHEMA_CHANNEL, size);
+    }
+
+    const uint8_t m_id;
+    const char* const m_name;
+    const std::array<const char*, sizeof...(Fields)> m_fieldNames;
+    bool m_schemaSent = false;
+    uint32_t m_schemaTime = 0;
+};
+} // namespace telemetry
\ No newline at end of file
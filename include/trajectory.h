@@ -0,0 +1,92 @@
+#pragma once
+#include "lemlib/asset.hpp"
+#include <cstdint>
+
+/**
+ * @brief Header of a trajectory asset. It is followed by six float arrays of
+ * TrajectoryHeader::count elements each: x, y, theta, velocity, angular
+ * velocity and acceleration.
+ *
+ * Trajectories are generated from the bezier curves in JerryIO's LemLib
+ * export by host/tools/generateTrajectory, see `make -C host trajectories`.
+ */
+struct TrajectoryHeader {
+    /** always Trajectory::MAGIC */
+    char magic[4];
+    /** format version, must match Trajectory::VERSION */
+    uint16_t version;
+    /** size of the header in bytes, the arrays start right after it */
+    uint16_t headerSize;
+    /** number of samples in the trajectory */
+    uint32_t count;
+    /** seconds between samples */
+    float period;
+};
+
+/** @brief Where the robot should be and how it should be moving at a time. */
+struct TrajectoryState {
+    /** inches */
+    float x;
+    float y;
+    /** heading, radians clockwise from +y */
+    float theta;
+    /** inches/s */
+    float velocity;
+    /** radians/s, positive clockwise */
+    float angularVelocity;
+    /** inches/s^2 */
+    float acceleration;
+};
+
+/**
+ * @brief A time parameterized trajectory, read straight out of its asset
+ * without parsing or copying.
+ *
+ * Sample i is where the robot should be i * period seconds after starting.
+ * The velocities are the fastest the drivetrain can follow the path at,
+ * within the limits it was generated with, starting and ending stopped.
+ */
+class Trajectory {
+  public:
+    static constexpr char MAGIC[4] = {'T', 'R', 'A', 'J'};
+    static constexpr uint16_t VERSION = 1;
+
+    /** @brief size of a trajectory with count samples, in bytes */
+    static constexpr uint32_t assetSize(uint32_t count) {
+      return sizeof(TrajectoryHeader) + 6 * count * sizeof(float);
+    }
+
+    /**
+     * @brief Checks the header of the asset. If the asset isn't a trajectory
+     * of the current version, an error is printed and the trajectory is
+     * empty.
+     */
+    explicit Trajectory(const asset& data);
+    /** @brief An empty trajectory, which isn't valid */
+    Trajectory() = default;
+
+    /** @returns whether the asset is a valid trajectory */
+    bool isValid() const;
+    /** @returns number of samples in the trajectory */
+    uint32_t size() const;
+    /** @returns seconds between samples */
+    float period() const;
+    /** @returns seconds from the first sample to the last */
+    float duration() const;
+
+    /**
+     * @returns the state time seconds after starting, interpolated between
+     * the samples around it. Before the start it's the first sample, after
+     * the end it's the last.
+     */
+    TrajectoryState sample(float time) const;
+  private:
+    uint32_t m_count = 0;
+    float m_period = 0;
+    const float* m_x = nullptr;
+    const float* m_y = nullptr;
+    const float* m_theta = nullptr;
+    const float* m_velocity = nullptr;
+    const float* m_angularVelocity = nullptr;
+    const float* m_acceleration = nullptr;
+};
\ No newline at end of file
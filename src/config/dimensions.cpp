@@ -3,8 +3,8 @@
 
 RobotConfig::Dimensions RobotConfig::Dimensions::dimensions = {
     .trackWidth = dimensions::robot::TRACK_WIDTH,
-    .driveWheelDiameter = 4.0,
-    .driveWheelRpm = 200,
+    .driveWheelDiameter = dimensions::robot::DRIVE_WHEEL_DIAMETER,
+    .driveWheelRpm = dimensions::robot::DRIVE_WHEEL_RPM,
     .driveEncGearRatio = 1.0,
     .vertEncDiameter = 2.0,
     .vertEncDistance = 2.0,
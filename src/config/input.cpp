@@ -0,0 +1,6 @@
+#include "subsystems/input.h"
+
+Input::Config Input::Config::config {
+    .period = 5,
+    .holdTime = 400,
+};
\ No newline at end of file
@@ -0,0 +1,12 @@
+#include "subsystems/intake.h"
+
+Intake::Config Intake::Config::config {
+    .updatePeriod = 5,
+    .liftLoadDelay = 100,
+    .liftReverseTime = 800,
+    .sortColor = RingColor::NONE,
+    .ejectDistance = 635,
+    .ringViewDistance = 265,
+    .ejectLead = 5,
+    .ejectPulse = 40,
+};
\ No newline at end of file
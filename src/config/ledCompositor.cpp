@@ -0,0 +1,4 @@
+#include "ledCompositor.h"
+
+/** 50Hz per port, the underglow strips share the expander on port 10 */
+LedCompositor::Config LedCompositor::Config::config {.flushInterval = 20};
\ No newline at end of file
@@ -7,6 +7,19 @@ Lift::Config Lift::Config::config {
     .middle = 320,
     .top = 355,
     .gearRatio = 1.0,
+    .updatePeriod = 5,
+    .profile = {.maxVelocity = 300, .maxAcceleration = 3000, .maxJerk = 30000},
+    .horizontal = 320,
+    .kG = 1500,
+    .kS = 255,
+    /** 12V moves the lift at about 400 deg/s */
+    .kV = 30,
+    .kA = 2.4,
+    .loadGain = 2,
+    .maxLoad = 1500,
+    .sweepRate = 500,
+    .sweepMaxAcceleration = 60,
+    /** kI and kD are per update, these match the old tune at 10ms */
     .controllerSettings =
-        lemlib::ControllerSettings {40, 10, 30, 0, 3, 150, 5, 300, 0},
+        lemlib::ControllerSettings {40, 5, 60, 0, 3, 150, 5, 300, 0},
 };
\ No newline at end of file
@@ -0,0 +1,17 @@
+#include "motionQueue.h"
+
+MotionQueue::Config MotionQueue::Config::config {
+    .period = 10,
+    .maxAcceleration = 120,
+    .maxDeceleration = 80,
+    .maxAngularAcceleration = 1500,
+    .maxAngularDeceleration = 900,
+    .kHeading = 4,
+    .blendDistance = 6,
+    .blendAngle = 10,
+    .settleDistance = 1,
+    .settleAngle = 2,
+    .ramseteB = 0.0013,
+    .ramseteZeta = 0.7,
+    .kAcceleration = 0.05,
+};
\ No newline at end of file
@@ -0,0 +1,12 @@
+#include "subsystems/ringDetector.h"
+
+RingDetector::Config RingDetector::Config::config {
+    .period = 5,
+    .enterProximity = 128,
+    .leaveProximity = 100,
+    .debounce = 15,
+    .redBelow = 30,
+    .redAbove = 330,
+    .blueAbove = 180,
+    .blueBelow = 260,
+};
\ No newline at end of file
@@ -0,0 +1,4 @@
+#include "screen.h"
+
+/** the brain's screen refreshes at about 30Hz */
+Screen::Config Screen::Config::config {.period = 33};
\ No newline at end of file
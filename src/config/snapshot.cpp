@@ -0,0 +1,5 @@
+#include "subsystems/snapshot.h"
+
+SensorSampler::Config SensorSampler::Config::config {
+    .period = 5,
+};
\ No newline at end of file
@@ -0,0 +1,3 @@
+#include "subsystems/telemetryStream.h"
+
+TelemetryStream::Config TelemetryStream::Config::config {.period = 10};
\ No newline at end of file
@@ -1,60 +1,98 @@
 #include "led.h"
 #include "pros/adi.hpp"
+#include <algorithm>
+#include <mutex>
 #include <cstddef>
 #include <cstdint>
-#include <cstdio>
 
-LedStrip::LedStrip(pros::adi::LED& led) : pros::adi::LED(led) {
-  super::clear();
+LedStrip::LedStrip(pros::adi::LED& led)
+  : pros::adi::LED(led), m_frame(super::_buffer.size(), 0),
+    m_handover(super::_buffer.size(), 0) {
+  LedCompositor::get()->addStrip(this);
+  update();
 }
 
-size_t LedStrip::getLength() const { return super::_buffer.size(); }
+LedStrip::~LedStrip() { LedCompositor::get()->removeStrip(this); }
+
+size_t LedStrip::getLength() const { return m_frame.size(); }
+
+size_t LedStrip::frameIndex(size_t index) const {
+  const size_t length = getLength();
+  return (index % length + length - m_rotation) % length;
+}
 
 void LedStrip::setPixel(size_t index, uint32_t color) {
-  super::set_pixel(color, index);
+  if (index >= getLength()) return;
+  m_frame[frameIndex(index)] = color;
 }
 
-void LedStrip::setAll(uint32_t color) { super::set_all(color); }
+void LedStrip::setAll(uint32_t color) {
+  std::fill(m_frame.begin(), m_frame.end(), color);
+  m_rotation = 0;
+  update();
+}
 
-void LedStrip::clear() { super::clear(); }
+void LedStrip::clear() { setAll(0); }
 
 void LedStrip::setGradient(HexRGB startColor, HexRGB endColor) {
-  const size_t length = this->getLength();
-  const HSV<float> startHSV =
-      HSV<float>::fromRGB(RGB<uint8_t>::fromHex(startColor));
-  const HSV<float> endHSV =
-      HSV<float>::fromRGB(RGB<uint8_t>::fromHex(endColor));
-
-  // the delta between each pixel
-  const HSV<float> delta = (endHSV - startHSV) / float(length - 1);
-
-  printf("start: %f %f %f\n", startHSV.h, startHSV.s, startHSV.v);
-  printf("end: %f %f %f\n", endHSV.h, endHSV.s, endHSV.v);
-  printf("delta: %f %f %f\n", delta.h, delta.s, delta.v);
-
-  for (size_t i = 0; i < length; ++i) {
-    const auto hsv = startHSV + delta * float(i);
-    printf("hsv: %f %f %f\n", hsv.h, hsv.s, hsv.v);
-    const auto rgb = hsvToRgb(hsv) * 255;
-    printf("rgb: %f %f %f\n", rgb.r, rgb.g, rgb.b);
-    _buffer[i] = rgbToHex(RGB<uint8_t>(rgb));
-  }
+  GradientEffect {startColor, endColor}.render(m_frame.data(), getLength(), 0);
+  m_rotation = 0;
+  update();
+}
 
-  for (auto color : _buffer) { printf("%x\n", color); }
+void LedStrip::shift(size_t distance) {
+  rotate(distance);
+  update();
+}
 
-  super::update();
+void LedStrip::rotate(size_t distance) {
+  if (getLength() == 0) return;
+  m_rotation = (m_rotation + distance) % getLength();
 }
 
-void LedStrip::shift(size_t distance) {
-  const size_t length = this->getLength();
-  distance %= length;
-
-  uint32_t prevColor = _buffer[length - 1];
-  for (auto it = _buffer.begin(); it != _buffer.end(); ++it) {
-    uint32_t temp = *it;
-    *it = prevColor;
-    prevColor = temp;
+void LedStrip::show(LedEffect& effect, uint32_t time) {
+  effect.render(m_frame.data(), getLength(), time);
+  for (HexRGB& color : m_frame) color = gammaCorrect(color);
+  m_rotation = 0;
+  update();
+}
+
+void LedStrip::update() {
+  const size_t length = getLength();
+  if (length == 0) return;
+  {
+    std::lock_guard lock(m_handoverMutex);
+    // the pixel shown first is the one rotated into place from the end
+    std::rotate_copy(m_frame.begin(), m_frame.begin() + frameIndex(0),
+                     m_frame.end(), m_handover.begin());
+    m_dirty = true;
   }
+  LedCompositor::get()->wake();
+}
+
+bool LedStrip::swapFrames() {
+  std::lock_guard lock(m_handoverMutex);
+  if (!m_dirty) return false;
+  // the old buffer becomes the next handover, update() overwrites all of it
+  std::swap(m_handover, super::_buffer);
+  m_dirty = false;
+  return true;
+}
+
+void LedStrip::flush() { super::update(); }
+
+uint8_t LedStrip::getPort() const { return super::_smart_port; }
+
+const HexRGB& LedStrip::operator[](int index) const {
+  return m_frame[frameIndex(index)];
+}
+
+const HexRGB& LedStrip::at(int index) const {
+  return m_frame.at(frameIndex(index));
+}
+
+std::vector<HexRGB>& LedStrip::getBuffer() { return m_frame; }
+
+const std::vector<HexRGB>& LedStrip::getBuffer() const { return m_frame; }
 
-  super::update();
-}
\ No newline at end of file
+size_t LedStrip::getRotation() const { return m_rotation; }
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "ledColor.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace {
+/** @brief hues per sector of the hue table */
+constexpr uint32_t SECTOR_STEPS = 64;
+/** @brief hues in the hue table, a multiple of 6 so primaries are exact */
+constexpr uint32_t HUE_STEPS = 6 * SECTOR_STEPS;
+
+/** @brief fully saturated, full brightness colors for HUE_STEPS hues */
+constexpr std::array<HexRGB, HUE_STEPS> HUE_TABLE = [] {
+  std::array<HexRGB, HUE_STEPS> table {};
+  for (uint32_t i = 0; i < HUE_STEPS; ++i) {
+    // 6 sectors, each ramping one channel up or down
+    const uint8_t rising = i % SECTOR_STEPS * 255 / (SECTOR_STEPS - 1);
+    const uint8_t falling = 255 - rising;
+    switch (i / SECTOR_STEPS) {
+      case 0: table[i] = hex(255, rising, 0); break;
+      case 1: table[i] = hex(falling, 255, 0); break;
+      case 2: table[i] = hex(0, 255, rising); break;
+      case 3: table[i] = hex(0, falling, 255); break;
+      case 4: table[i] = hex(rising, 0, 255); break;
+      default: table[i] = hex(255, 0, falling); break;
+    }
+  }
+  return table;
+}();
+
+constexpr float GAMMA = 2.2;
+
+/** @brief filled in once at startup */
+const std::array<uint8_t, 256> GAMMA_TABLE = [] {
+  std::array<uint8_t, 256> table {};
+  for (uint32_t i = 0; i < 256; ++i)
+    table[i] = std::lround(std::pow(i / 255.0f, GAMMA) * 255);
+  return table;
+}();
+
+/** @brief hue per sector of the color wheel */
+constexpr int32_t SECTOR = 65536 / 6;
+} // namespace
+
+HexRGB hsvToHex(HSV8 hsv) {
+  const HexRGB color = HUE_TABLE[hsv.h * HUE_STEPS >> 16];
+  // desaturate towards white, then darken
+  const auto channel = [&hsv](uint8_t value) -> uint8_t {
+    return scale8(255 - scale8(255 - value, hsv.s), hsv.v);
+  };
+  return hex(channel(red(color)), channel(green(color)), channel(blue(color)));
+}
+
+HSV8 hexToHsv(HexRGB color) {
+  const int32_t r = red(color), g = green(color), b = blue(color);
+  const int32_t max = std::max({r, g, b});
+  const int32_t delta = max - std::min({r, g, b});
+  HSV8 hsv {.h = 0, .s = 0, .v = uint8_t(max)};
+  if (delta == 0) return hsv;
+  hsv.s = delta * 255 / max;
+  int32_t h;
+  if (max == r) h = SECTOR * (g - b) / delta;
+  else if (max == g) h = 2 * SECTOR + SECTOR * (b - r) / delta;
+  else h = 4 * SECTOR + SECTOR * (r - g) / delta;
+  hsv.h = uint16_t(h);
+  return hsv;
+}
+
+HSV8 lerpHsv(HSV8 a, HSV8 b, uint8_t t) {
+  const auto lerp = [t](int32_t x, int32_t y) { return x + (y - x) * t / 255; };
+  return {.h = uint16_t(lerp(a.h, b.h)),
+          .s = uint8_t(lerp(a.s, b.s)),
+          .v = uint8_t(lerp(a.v, b.v))};
+}
+
+uint8_t gamma8(uint8_t value) { return GAMMA_TABLE[value]; }
+
+HexRGB gammaCorrect(HexRGB color) {
+  return hex(gamma8(red(color)), gamma8(green(color)), gamma8(blue(color)));
+}
\ No newline at end of file
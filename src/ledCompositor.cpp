@@ -0,0 +1,65 @@
+#include "ledCompositor.h"
+#include "led.h"
+#include <algorithm>
+#include <mutex>
+
+LedCompositor::LedCompositor(const Config& config)
+  : m_config(config), m_task {[this] {
+      while (true) pros::Task::notify_take(true, compose());
+    }, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "LedCompositor"} {}
+
+LedCompositor* LedCompositor::instance;
+
+LedCompositor* LedCompositor::get() {
+  if (LedCompositor::instance == nullptr)
+    LedCompositor::instance = new LedCompositor(Config::config);
+  return LedCompositor::instance;
+}
+
+void LedCompositor::wake() { m_task.notify(); }
+
+void LedCompositor::addStrip(LedStrip* strip) {
+  std::lock_guard lock(m_mutex);
+  m_strips.push_back({strip, 0});
+}
+
+void LedCompositor::removeStrip(LedStrip* strip) {
+  std::lock_guard lock(m_mutex);
+  m_strips.erase(std::remove_if(m_strips.begin(), m_strips.end(),
+                                [strip](const Entry& entry) {
+                                  return entry.strip == strip;
+                                }),
+                 m_strips.end());
+}
+
+uint32_t LedCompositor::compose() {
+  std::lock_guard lock(m_mutex);
+  const uint32_t now = pros::millis();
+  uint32_t wait = TIMEOUT_MAX;
+  for (Entry& entry : m_strips) {
+    LedStrip* strip = entry.strip;
+    if (!strip->m_dirty) continue;
+    const uint8_t port = std::min(strip->getPort(), MAX_PORT);
+    uint32_t& portFree = m_portFree[port];
+    if (int32_t(portFree - now) > 0) {
+      wait = std::min(wait, portFree - now);
+      continue;
+    }
+    // strips on the same port take turns, the one waiting longest goes first
+    const bool otherWaitedLonger =
+        std::any_of(m_strips.begin(), m_strips.end(), [&](const Entry& other) {
+          return other.strip->m_dirty && other.lastFlush < entry.lastFlush &&
+                 std::min(other.strip->getPort(), MAX_PORT) == port;
+        });
+    if (otherWaitedLonger) {
+      // the other strip goes now, so the port is next free a flush later
+      wait = std::min(wait, m_config.flushInterval);
+      continue;
+    }
+    if (!strip->swapFrames()) continue;
+    strip->flush();
+    entry.lastFlush = now;
+    portFree = now + m_config.flushInterval;
+  }
+  return wait;
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include "ledEffects.h"
+
+namespace {
+/** @return speed in pixels per second as pixels per ms in 16.16 fixed point */
+int32_t toFixedSpeed(float speed) { return speed * 65536 / 1000; }
+} // namespace
+
+GradientEffect::GradientEffect(HexRGB start, HexRGB end)
+  : m_start(hexToHsv(start)), m_end(hexToHsv(end)) {}
+
+void GradientEffect::render(HexRGB* pixels, size_t length, uint32_t) {
+  if (length == 1) pixels[0] = hsvToHex(m_start);
+  for (size_t i = 0; length > 1 && i < length; ++i)
+    pixels[i] = hsvToHex(lerpHsv(m_start, m_end, i * 255 / (length - 1)));
+}
+
+CycleEffect::CycleEffect(HexRGB start, HexRGB end, float speed)
+  : m_start(hexToHsv(start)), m_end(hexToHsv(end)),
+    m_speed(toFixedSpeed(speed)) {}
+
+void CycleEffect::render(HexRGB* pixels, size_t length, uint32_t time) {
+  // positions are in 16.16 fixed point pixels, the pattern repeats every strip
+  const int64_t period = int64_t(length) << 16;
+  const int64_t offset = int64_t(time) * m_speed % period;
+  for (size_t i = 0; i < length; ++i) {
+    int64_t position = ((int64_t(i) << 16) - offset) % period;
+    if (position < 0) position += period;
+    // there and back again, so the ends of the strip meet seamlessly
+    const int64_t triangle =
+        position < period / 2 ? position : period - position;
+    pixels[i] = hsvToHex(lerpHsv(m_start, m_end, triangle * 510 / period));
+  }
+}
+
+BreatheEffect::BreatheEffect(HexRGB color, uint32_t period)
+  : m_color(color), m_period(period) {}
+
+void BreatheEffect::render(HexRGB* pixels, size_t length, uint32_t time) {
+  const uint32_t phase = time % m_period * 510 / m_period;
+  // linear ramps look like a breath once the strip gamma corrects them
+  const uint8_t brightness = phase < 256 ? phase : 510 - phase;
+  const HexRGB color = scaleColor(m_color, brightness);
+  for (size_t i = 0; i < length; ++i) pixels[i] = color;
+}
+
+ChaseEffect::ChaseEffect(HexRGB color, HexRGB background, uint32_t tail,
+                         float speed)
+  : m_color(color), m_background(background), m_tail(tail),
+    m_speed(toFixedSpeed(speed)) {}
+
+void ChaseEffect::render(HexRGB* pixels, size_t length, uint32_t time) {
+  const int64_t period = int64_t(length) << 16;
+  int64_t head = int64_t(time) * m_speed % period;
+  if (head < 0) head += period;
+  const int64_t tail = int64_t(m_tail + 1) << 16;
+  for (size_t i = 0; i < length; ++i) {
+    // how far this pixel is behind the head, wrapping around the strip
+    const int64_t behind = (head + period - (int64_t(i) << 16)) % period;
+    pixels[i] = behind < tail ? lerpColor(m_color, m_background,
+                                          behind * 255 / tail)
+                              : m_background;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "logBuffer.h"
+#include <cstdio>
+
+LogBuffer::LogBuffer()
+  : m_task {[this] {
+      uint32_t now = pros::millis();
+      while (true) {
+        drain();
+        pros::Task::delay_until(&now, PERIOD);
+      }
+    }, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "LogBuffer"} {}
+
+LogBuffer* LogBuffer::instance;
+
+LogBuffer* LogBuffer::get() {
+  if (LogBuffer::instance == nullptr) LogBuffer::instance = new LogBuffer();
+  return LogBuffer::instance;
+}
+
+bool LogBuffer::write(const char* message, uint32_t size) {
+  size = std::min(size, MAX_MESSAGE);
+  for (Ring& ring : m_rings) {
+    if (ring.busy.exchange(true, std::memory_order_acquire)) continue;
+    const bool pushed = ring.ring.push(message, size);
+    ring.busy.store(false, std::memory_order_release);
+    if (pushed) m_written.fetch_add(1, std::memory_order_relaxed);
+    return pushed;
+  }
+  m_contended.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+LogBuffer::Stats LogBuffer::getStats() const {
+  Stats stats {m_written.load(std::memory_order_relaxed), 0,
+               m_contended.load(std::memory_order_relaxed)};
+  for (const Ring& ring : m_rings) stats.dropped += ring.ring.getDropped();
+  return stats;
+}
+
+void LogBuffer::drain() {
+  char message[MAX_MESSAGE];
+  // rings are drained one after another, so only messages written at the same
+  // time by different tasks can come out of order
+  for (Ring& ring : m_rings) {
+    int32_t size;
+    while ((size = ring.ring.pop(message, sizeof(message))) >= 0)
+      std::fwrite(message, 1, size, stdout);
+  }
+  const Stats stats = getStats();
+  const uint32_t drops = stats.dropped + stats.contended;
+  if (drops != m_reportedDrops) {
+    std::fprintf(stdout, "log: dropped %u messages\n", drops - m_reportedDrops);
+    m_reportedDrops = drops;
+  }
+  std::fflush(stdout);
+}
\ No newline at end of file
@@ -1,17 +1,10 @@
 #include "main.h"
 #include "config.h"
 #include "led.h"
+#include "logBuffer.h"
 #include "pros/rtos.hpp"
 #include "robot.h"
-
-void screen() {
-  while (1) {
-    pros::lcd::print(0, "target\tang\t=err");
-    pros::lcd::print(1, "%4.2f\t-%4.2f\t=%4.2f", bot.lift.getTargetAngle(),
-                     bot.lift.calcLiftAngle(), bot.lift.calcError());
-    pros::delay(50);
-  }
-}
+#include "screen.h"
 
 /**
  * Runs initialization code. This occurs as soon as the program is started.
@@ -21,9 +14,12 @@ void screen() {
  */
 void initialize() {
   pros::lcd::initialize();
+  // allocate the log buffer before anything logs from a control loop
+  LogBuffer::get();
 
   // ensure robot is initialized
   Robot::get();
+  bot.odom.calibrate();
 
   // // LED Testing
   // LedStrip leftStrip {RobotConfig::LEDs::leds.leftUnderGlow};
@@ -47,7 +43,9 @@ void initialize() {
   //   pros::delay(30);
   // }
 
-  new pros::Task {screen};
+  Screen::get()->setLine(0, "target\tang\t=err");
+  Screen::get()->setLine(1, "{:4.2f}\t-{:4.2f}\t={:4.2f}",
+                         {"lift.target", "lift.angle", "lift.error"});
 }
 
 /**
@@ -0,0 +1,111 @@
+#include "motionProfile.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+struct Trapezoid {
+    /** peak velocity, lower than the max on short moves */
+    float peak;
+    /** seconds spent accelerating, and again decelerating */
+    float accelTime;
+    /** seconds spent at peak velocity */
+    float cruiseTime;
+
+    Trapezoid(float distance, const ProfileConstraints& constraints)
+      : peak(std::min(constraints.maxVelocity,
+                      std::sqrt(distance * constraints.maxAcceleration))),
+        accelTime(peak / constraints.maxAcceleration),
+        cruiseTime(peak > 0 ? distance / peak - accelTime : 0) {}
+
+    float velocity(float time) const {
+      const float duration = 2 * accelTime + cruiseTime;
+      if (time <= 0 || time >= duration) return 0;
+      return peak * std::min({1.0f, time / accelTime,
+                              (duration - time) / accelTime});
+    }
+};
+
+/** @return samples in the window the velocity is averaged over */
+uint32_t smoothingWindow(const ProfileConstraints& constraints, float dt) {
+  if (constraints.maxJerk <= 0) return 1;
+  return std::max(1L, std::lround(constraints.maxAcceleration /
+                                  constraints.maxJerk / dt));
+}
+} // namespace
+
+uint32_t MotionProfile::sampleCount(float distance,
+                                    const ProfileConstraints& constraints,
+                                    float dt) {
+  const Trapezoid trapezoid(distance, constraints);
+  const float duration = 2 * trapezoid.accelTime + trapezoid.cruiseTime;
+  return std::ceil(duration / dt) + smoothingWindow(constraints, dt) + 1;
+}
+
+void MotionProfile::reserve(float distance,
+                            const ProfileConstraints& constraints, float dt) {
+  m_points.reserve(sampleCount(std::abs(distance), constraints, dt));
+}
+
+void MotionProfile::generate(float start, float end,
+                             const ProfileConstraints& constraints, float dt) {
+  m_dt = dt;
+  m_start = start;
+  m_end = end;
+  const float distance = std::abs(end - start);
+  const float direction = end < start ? -1 : 1;
+  const Trapezoid trapezoid(distance, constraints);
+  const uint32_t window = smoothingWindow(constraints, dt);
+  const uint32_t count = sampleCount(distance, constraints, dt);
+
+  // velocity of the trapezoid averaged over the last window samples
+  m_points.resize(count);
+  float sum = 0;
+  for (uint32_t i = 0; i < count; ++i) {
+    sum += trapezoid.velocity(i * dt);
+    if (i >= window) sum -= trapezoid.velocity((i - window) * dt);
+    m_points[i].velocity = sum / window;
+  }
+  m_points.back().velocity = 0;
+
+  // integrate, then scale out the error from sampling so the move ends exactly
+  // at end
+  float position = 0;
+  for (uint32_t i = 0; i < count; ++i) {
+    m_points[i].position = position;
+    if (i + 1 < count)
+      position += (m_points[i].velocity + m_points[i + 1].velocity) / 2 * dt;
+  }
+  const float scale = position > 0 ? distance / position : 0;
+  for (uint32_t i = 0; i < count; ++i) {
+    ProfilePoint& point = m_points[i];
+    const float nextVelocity = i + 1 < count ? m_points[i + 1].velocity : 0;
+    point.acceleration =
+        (nextVelocity - point.velocity) / dt * scale * direction;
+    point.velocity *= scale * direction;
+    point.position = start + point.position * scale * direction;
+  }
+  m_points.back().position = end;
+}
+
+ProfilePoint MotionProfile::at(float time) const {
+  if (m_points.empty()) return {m_end, 0, 0};
+  if (time <= 0) return m_points.front();
+  const uint32_t index = time / m_dt;
+  if (index + 1 >= m_points.size()) return {m_end, 0, 0};
+  // interpolate between samples, for callers that aren't in step with dt
+  const ProfilePoint& a = m_points[index];
+  const ProfilePoint& b = m_points[index + 1];
+  const float t = time / m_dt - index;
+  return {a.position + (b.position - a.position) * t,
+          a.velocity + (b.velocity - a.velocity) * t, a.acceleration};
+}
+
+float MotionProfile::getDuration() const {
+  return m_points.empty() ? 0 : (m_points.size() - 1) * m_dt;
+}
+
+float MotionProfile::getStart() const { return m_start; }
+
+float MotionProfile::getEnd() const { return m_end; }
+
+bool MotionProfile::isEmpty() const { return m_points.empty(); }
\ No newline at end of file
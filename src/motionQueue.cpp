@@ -0,0 +1,423 @@
+#include "motionQueue.h"
+#include "lemlib/util.hpp"
+#include "logger.h"
+#include <algorithm>
+#include <cmath>
+
+// every motion in the queue, the one being driven and the one popped to plan
+// for needs its own record
+static_assert(MotionQueue::QUEUE_SIZE / (sizeof(Motion) + 2) + 2 <
+                  MotionQueue::RECORDS,
+              "a queued motion's record could be reused");
+
+MotionQueue::MotionQueue(const lemlib::Drivetrain& drivetrain, Odometry& odom,
+                         const Config& config)
+  : m_drivetrain(drivetrain), m_odom(odom), m_config(config) {}
+
+MotionHandle MotionQueue::moveToPoint(float x, float y, int timeout,
+                                      lemlib::MoveToPointParams params) {
+  Motion motion;
+  motion.type = Motion::Type::MOVE_TO_POINT;
+  motion.forwards = params.forwards;
+  motion.direction = lemlib::AngularDirection::AUTO;
+  motion.x = x;
+  motion.y = y;
+  motion.theta = 0;
+  motion.lead = 0;
+  motion.maxSpeed = params.maxSpeed;
+  motion.minSpeed = params.minSpeed;
+  motion.earlyExitRange = params.earlyExitRange;
+  motion.lookahead = 0;
+  motion.slew = 0;
+  motion.timeout = timeout;
+  return push(motion);
+}
+
+MotionHandle MotionQueue::moveToPose(float x, float y, float theta,
+                                     int timeout,
+                                     lemlib::MoveToPoseParams params) {
+  Motion motion;
+  motion.type = Motion::Type::MOVE_TO_POSE;
+  motion.forwards = params.forwards;
+  motion.direction = lemlib::AngularDirection::AUTO;
+  motion.x = x;
+  motion.y = y;
+  motion.theta = theta;
+  motion.lead = params.lead;
+  motion.maxSpeed = params.maxSpeed;
+  motion.minSpeed = params.minSpeed;
+  motion.earlyExitRange = params.earlyExitRange;
+  motion.lookahead = 0;
+  motion.slew = 0;
+  motion.timeout = timeout;
+  return push(motion);
+}
+
+MotionHandle MotionQueue::turnToHeading(float theta, int timeout,
+                                        lemlib::TurnToHeadingParams params) {
+  Motion motion;
+  motion.type = Motion::Type::TURN_TO_HEADING;
+  motion.forwards = true;
+  motion.direction = params.direction;
+  motion.x = 0;
+  motion.y = 0;
+  motion.theta = theta;
+  motion.lead = 0;
+  motion.maxSpeed = params.maxSpeed;
+  motion.minSpeed = params.minSpeed;
+  motion.earlyExitRange = params.earlyExitRange;
+  motion.lookahead = 0;
+  motion.slew = 0;
+  motion.timeout = timeout;
+  return push(motion);
+}
+
+MotionHandle MotionQueue::turnToPoint(float x, float y, int timeout,
+                                      lemlib::TurnToPointParams params) {
+  Motion motion;
+  motion.type = Motion::Type::TURN_TO_POINT;
+  motion.forwards = params.forwards;
+  motion.direction = params.direction;
+  motion.x = x;
+  motion.y = y;
+  motion.theta = 0;
+  motion.lead = 0;
+  motion.maxSpeed = params.maxSpeed;
+  motion.minSpeed = params.minSpeed;
+  motion.earlyExitRange = params.earlyExitRange;
+  motion.lookahead = 0;
+  motion.slew = 0;
+  motion.timeout = timeout;
+  return push(motion);
+}
+
+MotionHandle MotionQueue::follow(const Path& path, float lookahead,
+                                 int timeout, bool forwards, float slew) {
+  if (!path.isValid()) return {};
+  Motion motion;
+  motion.type = Motion::Type::FOLLOW;
+  motion.forwards = forwards;
+  motion.direction = lemlib::AngularDirection::AUTO;
+  motion.x = 0;
+  motion.y = 0;
+  motion.theta = 0;
+  motion.lead = 0;
+  motion.maxSpeed = 127;
+  motion.minSpeed = 0;
+  motion.earlyExitRange = 0;
+  motion.path = path;
+  motion.lookahead = lookahead;
+  motion.slew = slew;
+  motion.timeout = timeout;
+  return push(motion);
+}
+
+MotionHandle MotionQueue::follow(const Trajectory& trajectory, int timeout) {
+  if (!trajectory.isValid()) return {};
+  Motion motion;
+  motion.type = Motion::Type::TRAJECTORY;
+  motion.forwards = true;
+  motion.direction = lemlib::AngularDirection::AUTO;
+  motion.x = 0;
+  motion.y = 0;
+  motion.theta = 0;
+  motion.lead = 0;
+  motion.maxSpeed = 127;
+  motion.minSpeed = 0;
+  motion.earlyExitRange = 0;
+  motion.lookahead = 0;
+  motion.slew = 0;
+  motion.trajectory = trajectory;
+  motion.timeout = timeout;
+  return push(motion);
+}
+
+MotionHandle MotionQueue::push(Motion motion) {
+  // checked before taking an id, so a full queue leaves every record alone.
+  // only this task pushes, so the room can't be taken before the push
+  if (QUEUE_SIZE - m_queue.used() < sizeof(Motion) + 2) {
+    logger::warn("MotionQueue: queue full");
+    return {};
+  }
+  // 0 is never used, so a zeroed record can't match a handle
+  if (++m_lastId == 0) ++m_lastId;
+  motion.id = m_lastId;
+  // no longer used by the executor, since the motion it was for has finished.
+  // handles to that motion stop matching before anything else changes, so
+  // they see it done rather than the new motion's state
+  Record& added = record(motion.id);
+  added.id.store(0);
+  added.done.store(false);
+  added.cancelled.store(false);
+  for (std::atomic<pros::task_t>& waiter : added.waiters)
+    waiter.store(nullptr);
+  added.triggerCount.store(0);
+  added.fired = 0;
+  added.travelled = 0;
+  added.id.store(motion.id);
+
+  // counted first, so the task can't finish it before it's counted
+  m_pending.fetch_add(1);
+  m_queue.push(&motion, sizeof(motion));
+
+  if (m_task == nullptr) {
+    m_task = new pros::Task {[this] {
+      uint32_t now = pros::millis();
+      uint64_t last = pros::micros();
+      while (true) {
+        const uint64_t time = pros::micros();
+        // the first step of a motion after idling is one period long
+        const float dt = m_current == nullptr
+                             ? m_config.period / 1000.0f
+                             : (time - last) / 1e6f;
+        last = time;
+        if (update(dt)) {
+          output();
+          pros::Task::delay_until(&now, m_config.period);
+          continue;
+        }
+
+        m_speed = 0;
+        m_angular = 0;
+        output();
+        pros::Task::notify_take(true, TIMEOUT_MAX);
+        now = pros::millis();
+        last = pros::micros();
+      }
+      // above autonomous, so the motion is stepped on time while it runs
+    }, TASK_PRIORITY_DEFAULT + 1, TASK_STACK_DEPTH_DEFAULT, "Motions"};
+  }
+  m_task->notify();
+  return {this, motion.id};
+}
+
+MotionQueue::Record& MotionQueue::record(uint32_t id) {
+  return m_records[id % RECORDS];
+}
+
+void MotionQueue::complete(Record& record) {
+  record.done.store(true);
+  for (std::atomic<pros::task_t>& slot : record.waiters) {
+    const pros::task_t waiter = slot.exchange(nullptr);
+    if (waiter != nullptr) pros::c::task_notify(waiter);
+  }
+}
+
+bool MotionQueue::peek() {
+  while (true) {
+    if (!m_hasNext) m_hasNext = m_queue.pop(&m_next, sizeof(m_next)) >= 0;
+    if (!m_hasNext) return false;
+    Record& next = record(m_next.id);
+    if (!next.cancelled.load() && !cleared(m_next.id)) return true;
+    // cancelled or cleared while it was queued, so it's over before it starts
+    m_pending.fetch_sub(1);
+    complete(next);
+    m_hasNext = false;
+  }
+}
+
+bool MotionQueue::cleared(uint32_t id) const {
+  // ids wrap, so compared by how far apart they are
+  return int32_t(id - m_clearedThrough.load()) <= 0;
+}
+
+bool MotionQueue::update(float dt) {
+  // a motion that ends hands over to the next one within the same step
+  while (m_current != nullptr || begin()) {
+    const bool running = !m_record->cancelled.load() &&
+                         !cleared(m_record->id.load()) &&
+                         pros::millis() - m_startedAt < m_timeout;
+    if (running && m_current->step(dt)) {
+      const lemlib::Pose pose = m_odom.getPose(true);
+      if (std::holds_alternative<TurnToHeadingMotion>(m_state))
+        m_record->travelled += lemlib::radToDeg(
+            std::abs(lemlib::angleError(pose.theta, m_lastPose.theta, true)));
+      else m_record->travelled += pose.distance(m_lastPose);
+      m_lastPose = pose;
+      trigger(m_current->progress());
+      return true;
+    }
+    finish(running);
+    // only stop if nothing was queued in time to carry on into
+    if (!peek()) return false;
+  }
+  return false;
+}
+
+void MotionQueue::trigger(float progress) {
+  const uint32_t count = m_record->triggerCount.load(std::memory_order_acquire);
+  for (uint32_t i = 0; i < count; ++i) {
+    const Record::Trigger& added = m_record->triggers[i];
+    if (m_record->fired >> i & 1) continue;
+    if ((added.progress ? progress : m_record->travelled) < added.threshold)
+      continue;
+    m_record->fired |= 1 << i;
+    added.callback();
+  }
+}
+
+bool MotionQueue::begin() {
+  if (!peek()) return false;
+  m_hasNext = false;
+  const Motion motion = m_next;
+  m_record = &record(motion.id);
+  switch (motion.type) {
+    case Motion::Type::MOVE_TO_POINT:
+    case Motion::Type::MOVE_TO_POSE:
+      m_current = &m_state.emplace<MoveToPointMotion>(*this, motion);
+      break;
+    case Motion::Type::TURN_TO_HEADING:
+    case Motion::Type::TURN_TO_POINT:
+      m_current = &m_state.emplace<TurnToHeadingMotion>(*this, motion);
+      break;
+    case Motion::Type::FOLLOW:
+      m_current = &m_state.emplace<FollowMotion>(*this, motion);
+      break;
+    case Motion::Type::TRAJECTORY:
+      m_current = &m_state.emplace<TrajectoryMotion>(*this, motion);
+      break;
+  }
+  m_timeout = motion.timeout;
+  m_startedAt = pros::millis();
+  m_lastPose = m_odom.getPose(true);
+  m_current->start();
+  return true;
+}
+
+void MotionQueue::finish(bool finished) {
+  if (finished) trigger(1);
+  m_current->done();
+  m_current = nullptr;
+  m_state.emplace<std::monostate>();
+  // uncounted before it's done, so waitUntilDone sees none pending once
+  // it's woken
+  m_pending.fetch_sub(1);
+  complete(*m_record);
+  m_record = nullptr;
+}
+
+float MotionQueue::exitSpeed(const Motion& motion, const lemlib::Pose& pose) {
+  const float top = maxVelocity();
+  const float minSpeed = motion.minSpeed / 127 * top;
+  // turning in place or reversing after the point means stopping on it
+  if (!peek() || !isMove(m_next) || m_next.forwards != motion.forwards)
+    return minSpeed;
+
+  // slowing down more the sharper the corner into the next move. a pose is
+  // passed through going the way it faces
+  const float in =
+      motion.type == Motion::Type::MOVE_TO_POSE
+          ? lemlib::degToRad(motion.theta) + (motion.forwards ? 0 : M_PI)
+          : std::atan2(motion.x - pose.x, motion.y - pose.y);
+  const float out = std::atan2(m_next.x - motion.x, m_next.y - motion.y);
+  const float corner = lemlib::angleError(out, in, true);
+  const float speed = std::min(motion.maxSpeed, m_next.maxSpeed) / 127 * top *
+                      (1 + std::cos(corner)) / 2;
+  return std::max(speed, minSpeed);
+}
+
+void MotionQueue::output() {
+  const float top = maxVelocity();
+  const float halfTrack = m_drivetrain.trackWidth / 2;
+  float left = m_speed + m_angular * halfTrack;
+  float right = m_speed - m_angular * halfTrack;
+  const float ratio = std::max(std::abs(left), std::abs(right)) / top;
+  if (ratio > 1) {
+    left /= ratio;
+    right /= ratio;
+  }
+  m_drivetrain.leftMotors->move(left / top * 127);
+  m_drivetrain.rightMotors->move(right / top * 127);
+}
+
+bool MotionQueue::isMove(const Motion& motion) {
+  return motion.type == Motion::Type::MOVE_TO_POINT ||
+         motion.type == Motion::Type::MOVE_TO_POSE;
+}
+
+float MotionQueue::maxVelocity() const {
+  return m_drivetrain.rpm / 60 * M_PI * m_drivetrain.wheelDiameter;
+}
+
+void MotionQueue::waitUntilDone() {
+  // motions end in the order they were queued, so once the last one has
+  // ended so has every other
+  while (m_pending.load() != 0) MotionHandle {this, m_lastId}.await();
+}
+
+void MotionQueue::clear() {
+  if (m_task == nullptr) return;
+  // by id rather than by draining the queue, so whatever is queued after
+  // this and before the executor next steps is kept
+  m_clearedThrough.store(m_lastId);
+  m_task->notify();
+}
+
+uint32_t MotionQueue::getPending() const { return m_pending.load(); }
+
+bool MotionHandle::isDone() const {
+  if (m_queue == nullptr) return true;
+  const MotionQueue::Record& record = m_queue->record(m_id);
+  // the record is reused long after its motion has ended
+  return record.id.load() != m_id || record.done.load();
+}
+
+void MotionHandle::await() const { waitFor(TIMEOUT_MAX); }
+
+bool MotionHandle::waitFor(uint32_t timeout) const {
+  if (isDone()) return true;
+  MotionQueue::Record& record = m_queue->record(m_id);
+  const pros::task_t current = pros::c::task_get_current();
+  std::atomic<pros::task_t>* slot = nullptr;
+  for (std::atomic<pros::task_t>& waiter : record.waiters) {
+    pros::task_t empty = nullptr;
+    if (waiter.compare_exchange_strong(empty, current)) {
+      slot = &waiter;
+      break;
+    }
+  }
+  const uint32_t start = pros::millis();
+  // woken by the executor when the motion ends, and checked again in case
+  // it ended before the waiter was set. without a slot, polled instead
+  while (!isDone()) {
+    const uint32_t elapsed = pros::millis() - start;
+    if (timeout != TIMEOUT_MAX && elapsed >= timeout) {
+      pros::task_t waiter = current;
+      if (slot != nullptr) slot->compare_exchange_strong(waiter, nullptr);
+      return false;
+    }
+    const uint32_t left =
+        timeout == TIMEOUT_MAX ? TIMEOUT_MAX : timeout - elapsed;
+    if (slot != nullptr) pros::Task::notify_take(true, left);
+    else pros::delay(std::min<uint32_t>(left, 10));
+  }
+  return true;
+}
+
+MotionHandle& MotionHandle::onDistance(float distance, Callback callback) {
+  return addTrigger(false, distance, callback);
+}
+
+MotionHandle& MotionHandle::onProgress(float fraction, Callback callback) {
+  return addTrigger(true, fraction, callback);
+}
+
+MotionHandle& MotionHandle::addTrigger(bool progress, float threshold,
+                                       Callback callback) {
+  if (isDone()) return *this;
+  MotionQueue::Record& record = m_queue->record(m_id);
+  const uint32_t count = record.triggerCount.load(std::memory_order_relaxed);
+  if (count == MotionQueue::MAX_CALLBACKS) {
+    logger::warn("MotionHandle: too many callbacks");
+    return *this;
+  }
+  // published to the executor by the count
+  record.triggers[count] = {progress, threshold, callback};
+  record.triggerCount.store(count + 1, std::memory_order_release);
+  return *this;
+}
+
+void MotionHandle::cancel() {
+  if (isDone()) return;
+  m_queue->record(m_id).cancelled.store(true);
+}
\ No newline at end of file
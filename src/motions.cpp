@@ -0,0 +1,147 @@
+#include "motions.h"
+#include "lemlib/util.hpp"
+#include "motionQueue.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+/**
+ * @return current moved towards target, speeding up by at most increase but
+ * slowing down straight away, since the planned speeds already slow down in
+ * time
+ */
+float accelerate(float target, float current, float increase) {
+  if (target * current >= 0 && std::abs(target) <= std::abs(current))
+    return target;
+  return lemlib::slew(target, current, increase);
+}
+} // namespace
+
+MoveToPointMotion::MoveToPointMotion(MotionQueue& queue, const Motion& motion)
+  : m_queue(queue), m_motion(motion) {}
+
+void MoveToPointMotion::start() {
+  const lemlib::Pose pose = m_queue.m_odom.getPose(true);
+  m_startDistance = std::hypot(m_motion.x - pose.x, m_motion.y - pose.y);
+  m_distance = m_startDistance;
+}
+
+bool MoveToPointMotion::step(float dt) {
+  const MotionQueue::Config& config = m_queue.m_config;
+  const lemlib::Pose pose = m_queue.m_odom.getPose(true);
+  const float exit = m_queue.exitSpeed(m_motion, pose);
+  const float dx = m_motion.x - pose.x;
+  const float dy = m_motion.y - pose.y;
+  const float distance = std::hypot(dx, dy);
+  m_distance = distance;
+  const float heading = m_motion.forwards ? pose.theta : pose.theta + M_PI;
+  const float error = lemlib::angleError(std::atan2(dx, dy), heading, true);
+  // distance left the way the robot is facing, negative once it's past
+  const float along = distance * std::cos(error);
+  const bool close = distance < config.blendDistance;
+  const bool toPose = m_motion.type == Motion::Type::MOVE_TO_POSE;
+  // a pose is driven at through a carrot point before it, so the robot
+  // arrives going the way it should end up facing, then lines up with it
+  float steer = error;
+  if (toPose) {
+    const float theta = lemlib::degToRad(m_motion.theta) +
+                        (m_motion.forwards ? 0 : M_PI);
+    const float carrotX =
+        m_motion.x - m_motion.lead * distance * std::sin(theta);
+    const float carrotY =
+        m_motion.y - m_motion.lead * distance * std::cos(theta);
+    steer = close ? lemlib::angleError(theta, heading, true)
+                  : lemlib::angleError(
+                        std::atan2(carrotX - pose.x, carrotY - pose.y),
+                        heading, true);
+  }
+
+  if (exit > 0) {
+    const float range = m_motion.earlyExitRange > 0 ? m_motion.earlyExitRange
+                                                    : config.blendDistance;
+    if (distance < range || (close && along <= 0)) return false;
+  } else if (distance < config.settleDistance || (close && along <= 0))
+    return false;
+
+  // fast enough to still slow down to the exit speed at the point
+  float target = std::sqrt(exit * exit + 2 * config.maxDeceleration *
+                                             std::max(along, 0.0f));
+  // the direction to the point swings around as the robot stops on it, but
+  // the heading of a pose doesn't
+  const float angular =
+      close && exit == 0 && !toPose ? 0 : config.kHeading * steer;
+  // turning towards the point before driving at it
+  const float maxSpeed = m_motion.maxSpeed / 127 * m_queue.maxVelocity();
+  target = std::min(target, maxSpeed) * std::max(std::cos(steer), 0.0f);
+  // leaving the outer wheel room to turn, so the robot keeps up with the
+  // carrot's curve instead of overshooting the heading of the pose
+  if (toPose) {
+    const float turning =
+        std::abs(angular) * m_queue.m_drivetrain.trackWidth / 2;
+    target = std::min(target,
+                      std::max(m_queue.maxVelocity() - turning, 0.0f));
+  }
+  m_queue.m_speed = accelerate(m_motion.forwards ? target : -target,
+                               m_queue.m_speed, config.maxAcceleration * dt);
+  m_queue.m_angular = angular;
+  return true;
+}
+
+float MoveToPointMotion::progress() const {
+  if (m_startDistance == 0) return 1;
+  return std::clamp(1 - m_distance / m_startDistance, 0.0f, 1.0f);
+}
+
+TurnToHeadingMotion::TurnToHeadingMotion(MotionQueue& queue,
+                                         const Motion& motion)
+  : m_queue(queue), m_motion(motion), m_direction(motion.direction) {}
+
+float TurnToHeadingMotion::target(const lemlib::Pose& pose) const {
+  if (m_motion.type == Motion::Type::TURN_TO_HEADING)
+    return lemlib::degToRad(m_motion.theta);
+  const float facing = std::atan2(m_motion.x - pose.x, m_motion.y - pose.y);
+  return m_motion.forwards ? facing : facing + M_PI;
+}
+
+void TurnToHeadingMotion::start() {
+  const lemlib::Pose pose = m_queue.m_odom.getPose(true);
+  m_startError = std::abs(
+      lemlib::angleError(target(pose), pose.theta, true, m_direction));
+  m_error = m_startError;
+}
+
+bool TurnToHeadingMotion::step(float dt) {
+  const MotionQueue::Config& config = m_queue.m_config;
+  const lemlib::Pose pose = m_queue.m_odom.getPose(true);
+  const float error =
+      lemlib::angleError(target(pose), pose.theta, true, m_direction);
+  // a forced direction is only needed until it's the short way round
+  if (std::abs(error) <= M_PI) m_direction = lemlib::AngularDirection::AUTO;
+  m_error = std::abs(error);
+  // a move after it takes over as soon as it's close
+  const bool blend = m_motion.minSpeed > 0 ||
+                     (m_queue.peek() && MotionQueue::isMove(m_queue.m_next));
+  float range = config.settleAngle;
+  if (blend)
+    range = m_motion.earlyExitRange > 0 ? m_motion.earlyExitRange
+                                        : config.blendAngle;
+  if (std::abs(error) < lemlib::degToRad(range)) return false;
+
+  const float deceleration = lemlib::degToRad(config.maxAngularDeceleration);
+  const float maxSpeed = m_motion.maxSpeed / 127 * m_queue.maxVelocity() /
+                         (m_queue.m_drivetrain.trackWidth / 2);
+  const float target =
+      std::min(std::sqrt(2 * deceleration * std::abs(error)), maxSpeed);
+  const float sign = (error > 0) - (error < 0);
+  m_queue.m_angular =
+      accelerate(sign * target, m_queue.m_angular,
+                 lemlib::degToRad(config.maxAngularAcceleration) * dt);
+  m_queue.m_speed =
+      lemlib::slew(0, m_queue.m_speed, config.maxDeceleration * dt);
+  return true;
+}
+
+float TurnToHeadingMotion::progress() const {
+  if (m_startError == 0) return 1;
+  return std::clamp(1 - m_error / m_startError, 0.0f, 1.0f);
+}
\ No newline at end of file
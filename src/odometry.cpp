@@ -0,0 +1,116 @@
+#include "odometry.h"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/util.hpp"
+#include <cmath>
+#include <mutex>
+
+Odometry::Odometry(SensorSampler& sampler, lemlib::OdomSensors& odomSensors,
+                   RobotConfig::Sensors& sensors)
+  : m_sampler(sampler), m_odomSensors(odomSensors), m_sensors(sensors) {}
+
+void Odometry::calibrate() {
+  // rotation sensors and the imu only accept multiples of 5ms
+  const uint32_t period = m_sampler.getPeriod();
+  m_sensors.vert.set_data_rate(period);
+  m_sensors.hori.set_data_rate(period);
+  m_sensors.imu.set_data_rate(period);
+
+  m_sensors.imu.reset(true);
+  if (m_odomSensors.vertical1 != nullptr) m_odomSensors.vertical1->reset();
+  if (m_odomSensors.horizontal1 != nullptr) m_odomSensors.horizontal1->reset();
+  m_calibratedAt = pros::micros();
+  m_primed = false;
+
+  if (m_task != nullptr) return;
+  m_task = new pros::Task {[this, period] {
+    while (true) {
+      // a missed notification only delays the update to the next snapshot
+      pros::Task::notify_take(true, 2 * period);
+      const SensorSnapshot snapshot = m_sampler.get();
+      if (snapshot.sequence == m_lastSequence) continue;
+      m_lastSequence = snapshot.sequence;
+      update(snapshot);
+    }
+  }, TASK_PRIORITY_DEFAULT + 1, TASK_STACK_DEPTH_DEFAULT, "Odometry"};
+  m_sampler.addListener(static_cast<pros::task_t>(*m_task));
+}
+
+lemlib::Pose Odometry::getPose(bool radians) {
+  std::lock_guard lock(m_mutex);
+  if (radians) return m_pose;
+  return {m_pose.x, m_pose.y, lemlib::radToDeg(m_pose.theta)};
+}
+
+void Odometry::setPose(lemlib::Pose pose, bool radians) {
+  if (!radians) pose.theta = lemlib::degToRad(pose.theta);
+  std::lock_guard lock(m_mutex);
+  m_pose = pose;
+  lemlib::setPose(pose, true);
+}
+
+lemlib::Pose Odometry::getVelocity(bool radians) {
+  std::lock_guard lock(m_mutex);
+  if (radians) return m_velocity;
+  return {m_velocity.x, m_velocity.y, lemlib::radToDeg(m_velocity.theta)};
+}
+
+uint64_t Odometry::getTimestamp() {
+  std::lock_guard lock(m_mutex);
+  return m_timestamp;
+}
+
+void Odometry::update(const SensorSnapshot& snapshot) {
+  if (snapshot.timestamp < m_calibratedAt) return;
+  const float imuRaw = lemlib::degToRad(snapshot.imuRotation);
+  if (!m_primed) {
+    m_prevVertical = snapshot.vertical;
+    m_prevHorizontal = snapshot.horizontal;
+    m_prevImu = imuRaw;
+    m_timestamp = snapshot.timestamp;
+    m_primed = true;
+    return;
+  }
+  lemlib::TrackingWheel* vertical = m_odomSensors.vertical1;
+  lemlib::TrackingWheel* horizontal = m_odomSensors.horizontal1;
+
+  const float deltaY = snapshot.vertical - m_prevVertical;
+  const float deltaX = snapshot.horizontal - m_prevHorizontal;
+  const float deltaHeading = imuRaw - m_prevImu;
+  m_prevVertical = snapshot.vertical;
+  m_prevHorizontal = snapshot.horizontal;
+  m_prevImu = imuRaw;
+
+  // same arc integration as lemlib
+  float localX = deltaX;
+  float localY = deltaY;
+  if (deltaHeading != 0) {
+    const float verticalOffset = vertical ? vertical->getOffset() : 0;
+    const float horizontalOffset = horizontal ? horizontal->getOffset() : 0;
+    localX = 2 * std::sin(deltaHeading / 2) *
+             (deltaX / deltaHeading + horizontalOffset);
+    localY = 2 * std::sin(deltaHeading / 2) *
+             (deltaY / deltaHeading + verticalOffset);
+  }
+
+  std::lock_guard lock(m_mutex);
+  const lemlib::Pose prevPose = m_pose;
+  const float avgHeading = m_pose.theta + deltaHeading / 2;
+  m_pose.x += localY * std::sin(avgHeading);
+  m_pose.y += localY * std::cos(avgHeading);
+  m_pose.x += localX * -std::cos(avgHeading);
+  m_pose.y += localX * std::sin(avgHeading);
+  m_pose.theta += deltaHeading;
+
+  // velocity uses the measured time between reads, not the period, so a late
+  // update doesn't look like a speed up
+  const float dt = (snapshot.timestamp - m_timestamp) / 1e6f;
+  m_timestamp = snapshot.timestamp;
+  if (dt > 0) {
+    const lemlib::Pose delta = m_pose - prevPose;
+    m_velocity.x = lemlib::ema(delta.x / dt, m_velocity.x, 0.95);
+    m_velocity.y = lemlib::ema(delta.y / dt, m_velocity.y, 0.95);
+    m_velocity.theta = lemlib::ema(deltaHeading / dt, m_velocity.theta, 0.95);
+  }
+
+  lemlib::setPose(m_pose, true);
+}
\ No newline at end of file
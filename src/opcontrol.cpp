@@ -2,52 +2,90 @@
 #include "pros/misc.h"
 #include "robot.h"
 
-namespace controller_mapping {
-const pros::controller_analog_e_t LEFT_DRIVE = pros::E_CONTROLLER_ANALOG_LEFT_Y;
-const pros::controller_analog_e_t RIGHT_DRIVE =
-    pros::E_CONTROLLER_ANALOG_RIGHT_Y;
-const pros::controller_digital_e_t INTAKE_MOGO = pros::E_CONTROLLER_DIGITAL_L1;
-const pros::controller_digital_e_t INTAKE_LIFT = pros::E_CONTROLLER_DIGITAL_R2;
-const pros::controller_digital_e_t OUTTAKE = pros::E_CONTROLLER_DIGITAL_L2;
-const pros::controller_digital_e_t MOGO = pros::E_CONTROLLER_DIGITAL_R1;
-const pros::controller_digital_e_t LIFT_UP = pros::E_CONTROLLER_DIGITAL_UP;
-const pros::controller_digital_e_t LIFT_DOWN = pros::E_CONTROLLER_DIGITAL_DOWN;
-}; // namespace controller_mapping
-namespace map = controller_mapping;
+namespace {
+using pros::E_CONTROLLER_ANALOG_LEFT_Y;
+using pros::E_CONTROLLER_ANALOG_RIGHT_Y;
+constexpr pros::controller_digital_e_t INTAKE_MOGO =
+    pros::E_CONTROLLER_DIGITAL_L1;
+constexpr pros::controller_digital_e_t INTAKE_LIFT =
+    pros::E_CONTROLLER_DIGITAL_R2;
+constexpr pros::controller_digital_e_t OUTTAKE = pros::E_CONTROLLER_DIGITAL_L2;
+constexpr pros::controller_digital_e_t MOGO = pros::E_CONTROLLER_DIGITAL_R1;
+constexpr pros::controller_digital_e_t LIFT_UP = pros::E_CONTROLLER_DIGITAL_UP;
+constexpr pros::controller_digital_e_t LIFT_DOWN =
+    pros::E_CONTROLLER_DIGITAL_DOWN;
+/** cycles the color the intake throws out: none, red, blue */
+constexpr pros::controller_digital_e_t SORT_COLOR =
+    pros::E_CONTROLLER_DIGITAL_B;
+/** held, and only away from competition control */
+constexpr pros::controller_digital_e_t LIFT_CHARACTERIZE =
+    pros::E_CONTROLLER_DIGITAL_X;
+
+void drive(const ControllerState& state) {
+  bot.tank(state.axis(E_CONTROLLER_ANALOG_LEFT_Y),
+           state.axis(E_CONTROLLER_ANALOG_RIGHT_Y));
+}
+
+/** the first intake button held wins */
+void updateIntake(const ControllerState& state) {
+  if (state.held(INTAKE_MOGO)) bot.intake.intake();
+  else if (state.held(INTAKE_LIFT)) bot.intake.intakeToLift();
+  else if (state.held(OUTTAKE)) bot.intake.outtake();
+  else bot.intake.stop();
+}
+
+void cycleSortColor(const ControllerState&) {
+  switch (bot.intake.getSortColor()) {
+    case RingColor::NONE: bot.intake.setSortColor(RingColor::RED); break;
+    case RingColor::RED: bot.intake.setSortColor(RingColor::BLUE); break;
+    case RingColor::BLUE: bot.intake.setSortColor(RingColor::NONE); break;
+  }
+}
+
+void characterizeLift(const ControllerState&) {
+  if (!pros::competition::is_connected()) bot.lift.characterize();
+}
+
+constexpr Bindings::Binding BINDING_LIST[] = {
+    {INTAKE_MOGO, InputEvent::PRESS, updateIntake},
+    {INTAKE_MOGO, InputEvent::RELEASE, updateIntake},
+    {INTAKE_LIFT, InputEvent::PRESS, updateIntake},
+    {INTAKE_LIFT, InputEvent::RELEASE, updateIntake},
+    {OUTTAKE, InputEvent::PRESS, updateIntake},
+    {OUTTAKE, InputEvent::RELEASE, updateIntake},
+    {MOGO, InputEvent::PRESS, [](const ControllerState&) {
+       bot.mogo.toggle();
+     }},
+    {LIFT_UP, InputEvent::PRESS, [](const ControllerState&) {
+       bot.lift.goUp();
+     }},
+    {LIFT_DOWN, InputEvent::PRESS, [](const ControllerState&) {
+       bot.lift.goDown();
+     }},
+    {SORT_COLOR, InputEvent::PRESS, cycleSortColor},
+    {LIFT_CHARACTERIZE, InputEvent::HOLD, characterizeLift},
+};
+static_assert(bindsEachOnce(BINDING_LIST), "the same event is bound twice");
+
+constexpr Bindings BINDINGS = makeBindings(drive, BINDING_LIST);
+} // namespace
 
 /**
- * Runs the operator control code. This function will be started in its own task
- * with the default priority and stack size whenever the robot is enabled via
- * the Field Management System or the VEX Competition Switch in the operator
- * control mode.
+ * Runs the operator control code. This function will be started in its own
+ * task with the default priority and stack size whenever the robot is enabled
+ * via the Field Management System or the VEX Competition Switch in the
+ * operator control mode.
  *
  * If no competition control is connected, this function will run immediately
  * following initialize().
  *
- * If the robot is disabled or communications is lost, the
- * operator control task will be stopped. Re-enabling the robot will restart the
- * task, not resume it from where it left off.
+ * If the robot is disabled or communications is lost, the operator control
+ * task will be stopped. Re-enabling the robot will restart the task, not
+ * resume it from where it left off. The bindings stay bound, but Input doesn't
+ * dispatch anything while disabled or during autonomous.
  */
 void opcontrol() {
-  pros::Controller master(pros::E_CONTROLLER_MASTER);
-
-  while (true) {
-    bot.tank(master.get_analog(map::LEFT_DRIVE),
-             master.get_analog(map::RIGHT_DRIVE));
-
-    // Intake control
-    if (master.get_digital(map::INTAKE_MOGO)) bot.intake.intake();
-    else if (master.get_digital(map::INTAKE_LIFT)) bot.intake.intakeToLift();
-    else if (master.get_digital(map::OUTTAKE)) bot.intake.outtake();
-    else bot.intake.stop();
-
-    // Mogo control
-    if (master.get_digital_new_press(map::MOGO)) bot.mogo.toggle();
-
-    // Lift control
-    if (master.get_digital_new_press(map::LIFT_UP)) bot.lift.goUp();
-    if (master.get_digital_new_press(map::LIFT_DOWN)) bot.lift.goDown();
-
-    pros::delay(20); // Run every 20ms (refresh rate of the controller)
-  }
+  // the controller is read and every binding runs on the SubsystemHandler's
+  // task, so that mechanisms react in the same tick as the press
+  bot.input.bind(&BINDINGS);
 }
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include "path.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+Path::Path(const asset& data) {
+  if (data.size < sizeof(PathHeader)) {
+    printf("path: asset too small for a header, is it compiled?\n");
+    return;
+  }
+  // the arrays are read in place, so the asset has to be aligned for floats
+  if (reinterpret_cast<uintptr_t>(data.buf) % alignof(float) != 0) {
+    printf("path: asset is not aligned\n");
+    return;
+  }
+  const PathHeader& header = *reinterpret_cast<const PathHeader*>(data.buf);
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+    printf("path: asset is not a compiled path\n");
+    return;
+  }
+  if (header.version != VERSION) {
+    printf("path: version %u, expected %u. recompile the path\n",
+           header.version, VERSION);
+    return;
+  }
+  if (header.count < 2 || header.headerSize != sizeof(PathHeader) ||
+      data.size < assetSize(header.count)) {
+    printf("path: asset is truncated\n");
+    return;
+  }
+
+  const float* arrays =
+      reinterpret_cast<const float*>(data.buf + header.headerSize);
+  m_count = header.count;
+  m_x = arrays;
+  m_y = m_x + m_count;
+  m_speed = m_y + m_count;
+  m_curvature = m_speed + m_count;
+  m_distance = m_curvature + m_count;
+  m_minX = m_distance + m_count;
+  m_minY = m_minX + m_count - 1;
+  m_maxX = m_minY + m_count - 1;
+  m_maxY = m_maxX + m_count - 1;
+}
+
+bool Path::isValid() const { return m_count != 0; }
+
+uint32_t Path::size() const { return m_count; }
+
+namespace {
+/**
+ * @returns how far along the segment p1 -> p2 it intersects the circle around
+ * center, from 0 to 1. -1 if it doesn't.
+ */
+float circleIntersect(const lemlib::Pose& p1, const lemlib::Pose& p2,
+                      const lemlib::Pose& center, float radius) {
+  const lemlib::Pose d = p2 - p1;
+  const lemlib::Pose f = p1 - center;
+  const float a = d * d;
+  const float b = 2 * (f * d);
+  const float c = (f * f) - radius * radius;
+  float discriminant = b * b - 4 * a * c;
+  if (discriminant >= 0) {
+    discriminant = std::sqrt(discriminant);
+    const float t1 = (-b - discriminant) / (2 * a);
+    const float t2 = (-b + discriminant) / (2 * a);
+    // prefer the intersection furthest along the path
+    if (t2 >= 0 && t2 <= 1) return t2;
+    if (t1 >= 0 && t1 <= 1) return t1;
+  }
+  return -1;
+}
+} // namespace
+
+PathIndex::PathIndex(const Path& path, float lookahead)
+  : m_path(path), m_lookahead(lookahead),
+    m_lastLookahead(path.point(0)) {}
+
+uint32_t PathIndex::updateClosest(const lemlib::Pose& pose) {
+  const float maxDistance = m_path.distance(m_closest) + m_lookahead;
+  const uint32_t end = std::min(m_path.size(), m_closest + MAX_WINDOW + 1);
+  float closestDist = pose.distance(m_path.point(m_closest));
+  // the next point is always checked, so the search can't get stuck where
+  // points are further apart than the lookahead
+  const uint32_t next = m_closest + 1;
+  for (uint32_t i = next;
+       i < end && (i == next || m_path.distance(i) <= maxDistance); ++i) {
+    const float dist = pose.distance(m_path.point(i));
+    if (dist < closestDist) {
+      closestDist = dist;
+      m_closest = i;
+    }
+  }
+  return m_closest;
+}
+
+lemlib::Pose PathIndex::updateLookahead(const lemlib::Pose& pose) {
+  const float radiusSquared = m_lookahead * m_lookahead;
+  const uint32_t start = std::max(m_closest, m_lookaheadSegment);
+  const uint32_t end = std::min(m_path.size() - 1, start + MAX_WINDOW);
+  for (uint32_t i = start; i < end; ++i) {
+    // distance from the robot to the nearest and furthest points of the box
+    const float nearX =
+        std::max({m_path.minX(i) - pose.x, 0.0f, pose.x - m_path.maxX(i)});
+    const float nearY =
+        std::max({m_path.minY(i) - pose.y, 0.0f, pose.y - m_path.maxY(i)});
+    const float farX = std::max(std::fabs(m_path.minX(i) - pose.x),
+                                std::fabs(m_path.maxX(i) - pose.x));
+    const float farY = std::max(std::fabs(m_path.minY(i) - pose.y),
+                                std::fabs(m_path.maxY(i) - pose.y));
+    if (nearX * nearX + nearY * nearY > radiusSquared) continue;
+    if (farX * farX + farY * farY < radiusSquared) continue;
+
+    const lemlib::Pose p1 = m_path.point(i);
+    const lemlib::Pose p2 = m_path.point(i + 1);
+    const float t = circleIntersect(p1, p2, pose, m_lookahead);
+    if (t != -1) {
+      m_lookaheadSegment = i;
+      m_lastLookahead = p1.lerp(p2, t);
+      break;
+    }
+  }
+  return m_lastLookahead;
+}
+
+uint32_t PathIndex::closest() const { return m_closest; }
+
+float PathIndex::progress() const { return m_path.distance(m_closest); }
\ No newline at end of file
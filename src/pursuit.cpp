@@ -0,0 +1,76 @@
+#include "lemlib/util.hpp"
+#include "motionQueue.h"
+#include "path.h"
+#include "robot.h"
+#include <cmath>
+
+// same pure pursuit as lemlib::Chassis::follow, reading a compiled Path
+// instead of parsing the JerryIO text every time a path is started, and
+// searching it incrementally with a PathIndex instead of from the start
+
+namespace {
+/** @returns curvature of the arc from pose to lookahead */
+float findLookaheadCurvature(const lemlib::Pose& pose, float heading,
+                             const lemlib::Pose& lookahead) {
+  const float side =
+      lemlib::sgn(std::sin(heading) * (lookahead.x - pose.x) -
+                  std::cos(heading) * (lookahead.y - pose.y));
+  const float a = -std::tan(heading);
+  const float b = 1;
+  const float c = std::tan(heading) * pose.x - pose.y;
+  const float x = std::fabs(a * lookahead.x + b * lookahead.y + c) /
+                  std::sqrt((a * a) + (b * b));
+  const float d = std::hypot(lookahead.x - pose.x, lookahead.y - pose.y);
+  return side * ((2 * x) / (d * d));
+}
+} // namespace
+
+FollowMotion::FollowMotion(MotionQueue& queue, const Motion& motion)
+  : m_queue(queue), m_motion(motion),
+    m_index(m_motion.path, motion.lookahead) {}
+
+void FollowMotion::start() {
+  // carry on at the speed the last motion left off at
+  m_prevVel = std::abs(m_queue.m_speed) / m_queue.maxVelocity() * 127;
+}
+
+bool FollowMotion::step(float) {
+  const Path& path = m_motion.path;
+  lemlib::Pose pose = m_queue.m_odom.getPose(true);
+  if (!m_motion.forwards) pose.theta -= M_PI;
+
+  const uint32_t closestPoint = m_index.updateClosest(pose);
+  // the last point of a path always has a speed of 0
+  if (path.speed(closestPoint) == 0) return false;
+
+  const lemlib::Pose lookaheadPose = m_index.updateLookahead(pose);
+
+  const float curvatureHeading = M_PI / 2 - pose.theta;
+  const float curvature =
+      findLookaheadCurvature(pose, curvatureHeading, lookaheadPose);
+
+  float targetVel = path.speed(closestPoint);
+  targetVel = lemlib::slew(targetVel, m_prevVel, m_motion.slew);
+  m_prevVel = targetVel;
+
+  // the queue sends the speed and turn as wheel speeds, limiting the faster
+  // wheel to the drivetrain's top speed like lemlib does
+  const float speed = targetVel / 127 * m_queue.maxVelocity();
+  m_queue.m_speed = m_motion.forwards ? speed : -speed;
+  m_queue.m_angular = speed * curvature;
+  return true;
+}
+
+float FollowMotion::progress() const {
+  const Path& path = m_motion.path;
+  return m_index.progress() / path.distance(path.size() - 1);
+}
+
+MotionHandle Robot::follow(const Path& path, float lookahead, int timeout,
+                           bool forwards, bool async) {
+  // slew is per step, and the queue steps at the same 10ms lemlib does
+  const MotionHandle handle = m_motions.follow(path, lookahead, timeout,
+                                               forwards, lateralSettings.slew);
+  if (!async) handle.await();
+  return handle;
+}
\ No newline at end of file
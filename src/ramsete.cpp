@@ -0,0 +1,52 @@
+#include "lemlib/util.hpp"
+#include "motionQueue.h"
+#include "robot.h"
+#include <algorithm>
+#include <cmath>
+
+// RAMSETE, as in "Control of Wheeled Mobile Robots: An Experimental Overview"
+// (Samson et al.), with headings clockwise from +y like the rest of lemlib
+
+TrajectoryMotion::TrajectoryMotion(MotionQueue& queue, const Motion& motion)
+  : m_queue(queue), m_motion(motion) {}
+
+bool TrajectoryMotion::step(float dt) {
+  const MotionQueue::Config& config = m_queue.m_config;
+  const Trajectory& trajectory = m_motion.trajectory;
+  m_elapsed += dt;
+  if (m_elapsed >= trajectory.duration()) return false;
+
+  const TrajectoryState target = trajectory.sample(m_elapsed);
+  const lemlib::Pose pose = m_queue.m_odom.getPose(true);
+  const float dx = target.x - pose.x;
+  const float dy = target.y - pose.y;
+  // error in the robot's frame, ahead of it and to its right
+  const float ahead = std::sin(pose.theta) * dx + std::cos(pose.theta) * dy;
+  const float right = std::cos(pose.theta) * dx - std::sin(pose.theta) * dy;
+  const float error = lemlib::angleError(target.theta, pose.theta, true);
+
+  const float b = config.ramseteB;
+  const float k =
+      2 * config.ramseteZeta *
+      std::sqrt(target.angularVelocity * target.angularVelocity +
+                b * target.velocity * target.velocity);
+  // sin(x)/x, which is 1 at 0
+  const float sinc = std::abs(error) < 1e-6f ? 1 : std::sin(error) / error;
+  const float velocity =
+      target.velocity + config.kAcceleration * target.acceleration;
+  m_queue.m_speed = velocity * std::cos(error) + k * ahead;
+  m_queue.m_angular = target.angularVelocity + k * error +
+                      b * target.velocity * sinc * right;
+  return true;
+}
+
+float TrajectoryMotion::progress() const {
+  return std::clamp(m_elapsed / m_motion.trajectory.duration(), 0.0f, 1.0f);
+}
+
+MotionHandle Robot::follow(const Trajectory& trajectory, int timeout,
+                           bool async) {
+  const MotionHandle handle = m_motions.follow(trajectory, timeout);
+  if (!async) handle.await();
+  return handle;
+}
\ No newline at end of file
@@ -27,9 +27,32 @@ Robot::Robot(const RobotConfig& config)
   : lemlib::Chassis(config.makeDrivetrain(), config.tunables.lateralController,
                     config.tunables.angularController, config.makeSensors(),
                     &config.tunables.driveCurve),
-    m_mogo {config.pneumatics.mogoClamp}, mogo(m_mogo),
-    m_intake {config.motors.intake, config.sensors.intake}, intake(m_intake),
-    m_lift {config.motors.lift, config.sensors.lift, Lift::Config::config},
-    lift(m_lift), m_config(config) {}
+    m_config(config),
+    m_sampler {config.sensors, sensors, SensorSampler::Config::config},
+    sampler(m_sampler),
+    m_ringDetector {m_sampler, RingDetector::Config::config},
+    ringDetector(m_ringDetector),
+    m_input {pros::E_CONTROLLER_MASTER, Input::Config::config}, input(m_input),
+    m_mogo {config.pneumatics.mogoClamp},
+    mogo(m_mogo),
+    m_intake {config.motors.intake, config.sensors.intake, m_sampler,
+              m_ringDetector, Intake::Config::config},
+    intake(m_intake),
+    m_lift {config.motors.lift, m_sampler, Lift::Config::config}, lift(m_lift),
+    m_odom {m_sampler, sensors, config.sensors}, odom(m_odom),
+    m_motions {drivetrain, m_odom, MotionQueue::Config::config},
+    motions(m_motions),
+    m_telemetry {m_odom, m_lift, TelemetryStream::Config::config},
+    m_leftUnderGlow {config.leds.leftUnderGlow},
+    m_rightUnderGlow {config.leds.rightUnderGlow},
+    leftUnderGlow(m_leftUnderGlow), rightUnderGlow(m_rightUnderGlow) {}
 
 Robot Robot::instance {RobotConfig::config};
+
+void Robot::setPose(float x, float y, float theta, bool radians) {
+  setPose({x, y, theta}, radians);
+}
+
+void Robot::setPose(lemlib::Pose pose, bool radians) {
+  m_odom.setPose(pose, radians);
+}
\ No newline at end of file
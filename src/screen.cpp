@@ -0,0 +1,82 @@
+#include "screen.h"
+#include "logger.h"
+#include "pros/llemu.hpp"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+Screen::Screen(const Config& config)
+  : m_config(config), m_task {[this] {
+      uint32_t now = pros::millis();
+      while (true) {
+        draw();
+        pros::Task::delay_until(&now, m_config.period);
+      }
+    }, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "Screen"} {}
+
+Screen* Screen::instance;
+
+Screen* Screen::get() {
+  if (Screen::instance == nullptr)
+    Screen::instance = new Screen(Config::config);
+  return Screen::instance;
+}
+
+Screen::Slot& Screen::slot(const char* name) {
+  std::lock_guard lock(m_mutex);
+  for (uint32_t i = 0; i < m_slotCount; ++i)
+    if (std::strcmp(m_slots[i].m_name, name) == 0) return m_slots[i];
+  if (m_slotCount == MAX_SLOTS) {
+    logger::warn("Screen: no room for slot {}", name);
+    return m_spareSlot;
+  }
+  Slot& slot = m_slots[m_slotCount++];
+  slot.m_name = name;
+  return slot;
+}
+
+void Screen::setLine(int line, const char* format,
+                     std::initializer_list<const char*> slots) {
+  if (line < 0 || line >= LINES) return;
+  Slot* lineSlots[MAX_LINE_SLOTS] {};
+  uint32_t count = 0;
+  for (const char* name : slots)
+    if (count < MAX_LINE_SLOTS) lineSlots[count++] = &slot(name);
+  std::lock_guard lock(m_mutex);
+  Line& target = m_lines[line];
+  target.format = format;
+  std::copy(std::begin(lineSlots), std::end(lineSlots), target.slots);
+}
+
+void Screen::setText(int line, const char* text) {
+  if (line < 0 || line >= LINES) return;
+  Text buffer {};
+  std::strncpy(buffer.data(), text, buffer.size() - 1);
+  m_lines[line].text.write(buffer);
+}
+
+uint32_t Screen::getRedraws() const { return m_redraws; }
+
+void Screen::draw() {
+  std::lock_guard lock(m_mutex);
+  for (int i = 0; i < LINES; ++i) {
+    Line& line = m_lines[i];
+    Text text {};
+    if (line.format != nullptr) {
+      float values[MAX_LINE_SLOTS] {};
+      for (uint32_t j = 0; j < MAX_LINE_SLOTS; ++j)
+        if (line.slots[j] != nullptr) values[j] = line.slots[j]->get();
+      // unused values are ignored by fmt, so every line takes all of them
+      const auto result = fmt::vformat_to_n(
+          text.data(), text.size() - 1, line.format,
+          fmt::make_format_args(values[0], values[1], values[2], values[3]));
+      *result.out = '\0';
+    } else {
+      text = line.text.read();
+    }
+    if (text == line.drawn) continue;
+    if (!pros::lcd::print(i, "%s", text.data())) continue;
+    line.drawn = text;
+    m_redraws.fetch_add(1, std::memory_order_relaxed);
+  }
+}
\ No newline at end of file
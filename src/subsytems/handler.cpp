@@ -1,15 +1,19 @@
 #include "pros/rtos.hpp"
 #include "subsystems.h"
-#include <sys/_intsup.h>
+#include <algorithm>
+#include <mutex>
 
 SubsystemHandler::SubsystemHandler()
-  : m_lastUsedId(0), m_subsystems {}, m_task {[this] {
-      uint32_t now = pros::millis();
+  : m_lastUsedId(0), m_registry(new Registry {}), m_retired(nullptr),
+    m_updating(false), m_passes(0), m_task {[this] {
       while (true) {
-        for (auto sub : m_subsystems) sub.second->update();
-        pros::c::task_delay_until(&now, 10);
+        const uint64_t next = update();
+        const uint64_t now = pros::micros();
+        // sleep until the next update is due, unless woken up by wake()
+        if (next > now)
+          pros::Task::notify_take(true, (next - now + 999) / 1000);
       }
-    }} {}
+    }, "SubsystemHandler"} {}
 
 SubsystemHandler* SubsystemHandler::instance;
 
@@ -20,10 +24,96 @@ SubsystemHandler* SubsystemHandler::get() {
 }
 
 int SubsystemHandler::addSubsystem(Subsystem* subsystem) {
-  m_subsystems.emplace(++m_lastUsedId, subsystem);
+  std::lock_guard lock(m_writeMutex);
+  Registry* registry = new Registry {m_registry.load()->entries};
+  // insert after every subsystem of the same or an earlier stage
+  const auto it = std::upper_bound(
+      registry->entries.begin(), registry->entries.end(), subsystem->m_stage,
+      [](Subsystem::Stage stage, const Entry& entry) {
+        return stage < entry.subsystem->m_stage;
+      });
+  registry->entries.insert(it, Entry {++m_lastUsedId, subsystem});
+  publish(registry);
   return m_lastUsedId;
 }
 
 void SubsystemHandler::removeSubsystem(int subsystemId) {
-  m_subsystems.erase(subsystemId);
+  {
+    std::lock_guard lock(m_writeMutex);
+    Registry* registry = new Registry {m_registry.load()->entries};
+    std::erase_if(registry->entries, [subsystemId](const Entry& entry) {
+      return entry.id == subsystemId;
+    });
+    publish(registry);
+  }
+
+  // wait for the task to finish walking the old registry, unless this is the
+  // task removing a subsystem from within an update
+  if (pros::c::task_get_current() == static_cast<pros::task_t>(m_task))
+    return;
+  const uint32_t passes = m_passes;
+  while (m_updating && m_passes == passes) pros::delay(1);
+}
+
+void SubsystemHandler::publish(Registry* registry) {
+  Registry* old = m_registry.exchange(registry);
+  old->nextRetired = m_retired.load();
+  while (!m_retired.compare_exchange_weak(old->nextRetired, old));
+}
+
+void SubsystemHandler::reclaim() {
+  Registry* retired = m_retired.exchange(nullptr);
+  while (retired != nullptr) {
+    Registry* next = retired->nextRetired;
+    delete retired;
+    retired = next;
+  }
+}
+
+void SubsystemHandler::wake() { m_task.notify(); }
+
+uint64_t SubsystemHandler::update() {
+  // nothing retired before this point can still be in use
+  reclaim();
+  m_updating = true;
+  const Registry* registry = m_registry.load();
+
+  uint64_t next = UINT64_MAX;
+  for (const Entry& entry : registry->entries) {
+    Subsystem* sub = entry.subsystem;
+    const bool periodic = sub->m_period != Subsystem::EVENT_DRIVEN;
+    const uint64_t period = uint64_t(sub->m_period) * 1000;
+    uint64_t start = pros::micros();
+    // the first update sets the phase of every update after it
+    if (periodic && sub->m_stats.updates == 0) sub->m_nextUpdate = start;
+
+    const bool due = periodic && start >= sub->m_nextUpdate;
+    if (sub->m_updateRequested.exchange(false) || due) {
+      start = pros::micros();
+      sub->update();
+      const uint64_t end = pros::micros();
+
+      SubsystemStats& stats = sub->m_stats;
+      ++stats.updates;
+      stats.lastExecTime = end - start;
+      stats.maxExecTime = std::max(stats.maxExecTime, stats.lastExecTime);
+      stats.totalExecTime += stats.lastExecTime;
+      if (due) {
+        stats.lastJitter = start - sub->m_nextUpdate;
+        stats.maxJitter = std::max(stats.maxJitter, stats.lastJitter);
+        // every period that has already started by the time the update
+        // finished was missed
+        sub->m_nextUpdate += period;
+        while (sub->m_nextUpdate <= end) {
+          sub->m_nextUpdate += period;
+          ++stats.missedDeadlines;
+        }
+      }
+    }
+    if (periodic) next = std::min(next, sub->m_nextUpdate);
+  }
+
+  m_updating = false;
+  ++m_passes;
+  return next;
 }
\ No newline at end of file
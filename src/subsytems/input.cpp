@@ -0,0 +1,63 @@
+#include "subsystems/input.h"
+#include "logger.h"
+
+Input::Input(pros::controller_id_e_t id, const Config& config)
+  : Subsystem(config.period, Stage::SENSOR), m_controller(id),
+    m_config(config) {}
+
+void Input::update() {
+  ControllerState state;
+  state.timestamp = pros::micros();
+  for (uint32_t i = 0; i < ControllerState::BUTTONS; ++i) {
+    const auto button = pros::controller_digital_e_t(
+        pros::E_CONTROLLER_DIGITAL_L1 + i);
+    if (m_controller.get_digital(button)) state.buttons |= 1 << i;
+  }
+  for (uint32_t i = 0; i < 4; ++i)
+    state.axes[i] = m_controller.get_analog(pros::controller_analog_e_t(i));
+
+  // edges since the last read, then holds, in the order they happened
+  const uint16_t changed = state.buttons ^ m_state.buttons;
+  for (uint32_t i = 0; i < ControllerState::BUTTONS; ++i) {
+    if (!(changed >> i & 1)) continue;
+    if (state.buttons >> i & 1) {
+      m_pressedAt[i] = state.timestamp;
+      m_holdSent &= ~(1 << i);
+      push(InputEvent::PRESS, i, state.timestamp);
+    } else push(InputEvent::RELEASE, i, state.timestamp);
+  }
+  for (uint32_t i = 0; i < ControllerState::BUTTONS; ++i) {
+    if (!(state.buttons >> i & 1) || m_holdSent >> i & 1) continue;
+    if (state.timestamp - m_pressedAt[i] < m_config.holdTime * 1000) continue;
+    m_holdSent |= 1 << i;
+    push(InputEvent::HOLD, i, state.timestamp);
+  }
+  m_state = state;
+  m_published.write(state);
+
+  const Bindings* bindings = m_bindings.load(std::memory_order_acquire);
+  const bool driving = !pros::competition::is_autonomous() &&
+                       !pros::competition::is_disabled();
+  InputEvent event;
+  while (m_events.pop(&event, sizeof(event)) == int32_t(sizeof(event))) {
+    if (!bindings || !driving) continue;
+    const Bindings::Action action =
+        bindings->actions[ControllerState::index(event.button)][event.type];
+    if (action) action(state);
+  }
+  if (bindings && driving && bindings->everyRead) bindings->everyRead(state);
+}
+
+void Input::bind(const Bindings* bindings) {
+  m_bindings.store(bindings, std::memory_order_release);
+}
+
+ControllerState Input::getState() const { return m_published.read(); }
+
+void Input::push(InputEvent::Type type, uint32_t button, uint64_t timestamp) {
+  const auto digital =
+      pros::controller_digital_e_t(pros::E_CONTROLLER_DIGITAL_L1 + button);
+  const InputEvent event {type, digital, timestamp};
+  if (!m_events.push(&event, sizeof(event)))
+    logger::warn("Input: event queue full");
+}
\ No newline at end of file
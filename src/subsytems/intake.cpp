@@ -1,9 +1,19 @@
 #include "subsystems/intake.h"
-#include "pros/llemu.hpp"
+#include "debug.h"
+#include "logger.h"
 #include "pros/optical.hpp"
+#include <algorithm>
+#include <cmath>
 
-Intake::Intake(pros::MotorGroup& motors, pros::Optical& optical)
-  : m_motors(motors), m_optical(optical) {
+/** intake motor degrees between rings on the chain, at least */
+constexpr float MIN_RING_SPACING = 90;
+
+Intake::Intake(pros::MotorGroup& motors, pros::Optical& optical,
+               const SensorSampler& sensors, RingDetector& detector,
+               const Config& config)
+  : Subsystem(config.updatePeriod), m_motors(motors), m_optical(optical),
+    m_sensors(sensors), m_detector(detector), m_config(config),
+    m_sortColor(config.sortColor) {
   m_optical.set_led_pwm(100);
 }
 
@@ -12,12 +22,49 @@ const Intake::State& Intake::getState() const { return m_state; }
 void Intake::update() {
   const State prevState = m_state;
 
-  int proximity = m_optical.get_proximity();
-  pros::lcd::print(5, "intake: %i", proximity);
-  if (proximity > 128) {
-    if (m_startSensingRingTimestamp == 0)
-      m_startSensingRingTimestamp = pros::millis();
-  } else m_startSensingRingTimestamp = 0;
+  int proximity = m_sensors.get().intakeProximity;
+  debug::lcd<debug::INTAKE>(5, "intake: {}", proximity);
+  const float position = m_motors.get_position();
+  // rpm to degrees/s
+  const float velocity = m_motors.get_actual_velocity() * 6;
+  const RingColor sortColor = m_sortColor.load(std::memory_order_relaxed);
+  RingEvent event;
+  while (m_detector.poll(event)) {
+    logger::debug(
+        "intake: ring {} at {}us, hue {:.0f}",
+        event.type == RingEvent::Type::ENTERED ? "entered" : "left",
+        event.timestamp, event.hue);
+    const bool entered = event.type == RingEvent::Type::ENTERED;
+    // where the intake was when the event happened, not now
+    const float since = (pros::micros() - event.timestamp) / 1e6f;
+    const float eventPosition = position - velocity * since;
+    const bool wrongColor =
+        sortColor != RingColor::NONE && event.color == sortColor;
+    if (entered) m_viewStart = eventPosition;
+    else if (wrongColor &&
+             eventPosition - m_viewStart > 1.5f * m_config.ringViewDistance) {
+      // two rings of the same color touching, the second entered one ring
+      // before the end
+      scheduleEject(eventPosition - m_config.ringViewDistance +
+                    m_config.ejectDistance);
+    }
+    if (entered && wrongColor) {
+      scheduleEject(eventPosition + m_config.ejectDistance);
+      // and don't hook it onto the lift
+      continue;
+    }
+    m_ringEnteredAt = entered ? event.timestamp : 0;
+  }
+  // rings going back out the front won't reach the top
+  if (m_state == OUT) m_ejectCount = 0;
+
+  if (m_ejectUntil != 0 && pros::millis() >= m_ejectUntil) m_ejectUntil = 0;
+  if (m_ejectUntil == 0 && (m_state == IN || m_state == IN_TO_LIFT))
+    checkEject(position, velocity);
+  if (m_ejectUntil != 0) {
+    m_motors.move(-127);
+    return;
+  }
 
   switch (m_state) {
     case IN: m_motors.move(127); break;
@@ -25,23 +72,51 @@ void Intake::update() {
     case IDLE: m_motors.move(0); break;
     case IN_TO_LIFT:
       m_motors.move(96);
-      if (m_startSensingRingTimestamp != 0 &&
-          pros::millis() - m_startSensingRingTimestamp > 100)
+      if (m_ringEnteredAt != 0 &&
+          pros::micros() - m_ringEnteredAt >= m_config.liftLoadDelay * 1000)
         setState(OUT_TO_LIFT);
       break;
     case OUT_TO_LIFT:
       m_motors.move(-127);
-      if (pros::millis() - m_switchStateTimestamp > 800) setState(IN_TO_LIFT);
+      // the ring is on the lift once it's backed off the sensor
+      if (m_ringEnteredAt == 0 ||
+          pros::millis() - m_switchStateTimestamp > m_config.liftReverseTime)
+        setState(IN_TO_LIFT);
       break;
   }
 
   if (prevState != m_state) update();
 }
 
+void Intake::scheduleEject(float position) {
+  // a ring that backed off the sensor and was seen again is already queued
+  for (uint32_t i = 0; i < m_ejectCount; ++i)
+    if (std::abs(m_ejectAt[i] - position) < MIN_RING_SPACING) return;
+  if (m_ejectCount == MAX_EJECTS) {
+    logger::warn("intake: too many rings to eject");
+    return;
+  }
+  m_ejectAt[m_ejectCount++] = position;
+}
+
+void Intake::checkEject(float position, float velocity) {
+  if (m_ejectCount == 0) return;
+  const float remaining = m_ejectAt[0] - position;
+  // start the pulse in the update closest to when it has to start
+  const float lead = (m_config.ejectLead + getPeriod() / 2.0f) / 1000;
+  if (remaining > 0 && (velocity <= 0 || remaining > velocity * lead)) return;
+  m_ejectUntil = pros::millis() + m_config.ejectPulse;
+  ++m_ejected;
+  std::copy(m_ejectAt + 1, m_ejectAt + m_ejectCount, m_ejectAt);
+  --m_ejectCount;
+  debug::print<debug::INTAKE>("intake: ejecting, {:.0f}deg early", remaining);
+}
+
 void Intake::setState(State state) {
   m_switchStateTimestamp = pros::millis();
   m_state = state;
-  update();
+  // update on the SubsystemHandler's task, the only one that polls events
+  requestUpdate();
 }
 
 void Intake::stop() { setState(IDLE); }
@@ -50,4 +125,18 @@ void Intake::intake() { setState(IN); }
 
 void Intake::outtake() { setState(OUT); }
 
-void Intake::intakeToLift() { setState(IN_TO_LIFT); }
\ No newline at end of file
+void Intake::intakeToLift() { setState(IN_TO_LIFT); }
+
+void Intake::setSortColor(RingColor color) {
+  m_sortColor.store(color, std::memory_order_relaxed);
+  const char* name = color == RingColor::RED    ? "red"
+                     : color == RingColor::BLUE ? "blue"
+                                                : "nothing";
+  logger::info("intake: sorting out {}", name);
+}
+
+RingColor Intake::getSortColor() const {
+  return m_sortColor.load(std::memory_order_relaxed);
+}
+
+uint32_t Intake::getEjected() const { return m_ejected; }
\ No newline at end of file
@@ -1,45 +1,141 @@
 #include "subsystems/lift.h"
-#include "pros/llemu.hpp"
+#include "debug.h"
+#include "lemlib/util.hpp"
+#include "logger.h"
 #include "pros/motors.h"
-#include "pros/rotation.hpp"
+#include <algorithm>
 #include <cmath>
 
 void Lift::update() {
   if (m_state == State::EMERGENCY_STOP) {
     m_motors.set_brake_mode(pros::E_MOTOR_BRAKE_BRAKE);
     m_motors.brake();
+    m_output = 0;
     return;
   }
+  if (m_stateChanged.exchange(false, std::memory_order_acquire)) startMove();
+  if (m_state == State::CHARACTERIZE) {
+    sweep();
+    return;
+  }
+
+  const float angle = calcLiftAngle();
   const float error = calcError();
-  const float output = m_pid.update(error);
-  bool shouldBrake = m_exitCondition.update(error);
-  if (pros::millis() % 200 < 10) printf("lift: %4.2f\t%4.2f\n", error, output);
-  if (shouldBrake) {
-    // if error > smallError, then don't brake and reset exit condition
-    if (std::abs(error) > m_config.controllerSettings.smallError)
-      m_exitCondition.reset();
-    else {
-      m_motors.set_brake_mode(pros::E_MOTOR_BRAKE_HOLD);
-      m_motors.brake();
-      pros::lcd::print(2, "braking");
-      return;
-    }
+  m_targetSlot.set(getTargetAngle());
+  m_angleSlot.set(angle);
+  m_errorSlot.set(error);
+
+  // follow the move's profile, then hold the target
+  ProfilePoint setpoint {getTargetAngle(), 0, 0};
+  bool moving = false;
+  if (m_profile != nullptr) {
+    const float time = (pros::millis() - m_profileStart) / 1000.0f;
+    moving = time < m_profile->getDuration();
+    setpoint = m_profile->at(time);
+  }
+  const float gravity =
+      std::cos(lemlib::degToRad(setpoint.position - m_config.horizontal));
+  const float direction = (setpoint.velocity > 0) - (setpoint.velocity < 0);
+  const float feedback = m_pid.update(setpoint.position - angle);
+  const float output = (m_config.kG + m_load) * gravity +
+                       m_config.kS * direction +
+                       m_config.kV * setpoint.velocity +
+                       m_config.kA * setpoint.acceleration + feedback;
+  // the feedforward holds the lift once it's settled, instead of braking,
+  // since hold mode sags under a ring and chatters against gravity
+  bool settled = !moving && m_exitCondition.update(error);
+  if (settled && std::abs(error) > m_config.controllerSettings.smallError) {
+    m_exitCondition.reset();
+    settled = false;
+  }
+  // whatever the pid needs to hold the lift still is load the feedforward
+  // doesn't know about, like a ring. Learning it means it's there from the
+  // start of the next move, when the pid has been reset
+  if (settled && gravity > 0.5f) {
+    m_load = std::clamp(m_load + m_config.loadGain * feedback / gravity *
+                                     m_config.updatePeriod / 1000.0f,
+                        -m_config.maxLoad, m_config.maxLoad);
   }
-  pros::lcd::print(2, "output: %4.2f", output);
+  debug::print<debug::LIFT>("lift: {:.2f}\t{:.2f}\t{:.0f}", error, output,
+                            m_load);
+  if (settled) debug::lcd<debug::LIFT>(2, "holding: {:.2f}", output);
+  else debug::lcd<debug::LIFT>(2, "output: {:.2f}", output);
   m_motors.move_voltage(output);
+  m_output = output;
 }
 
-Lift::Lift(pros::MotorGroup& motors, pros::Rotation& rotation, Config& config)
-  : m_state(State::BOTTOM), m_config(config), m_motors(motors),
-    m_rotation(rotation),
+Lift::Lift(pros::MotorGroup& motors, const SensorSampler& sensors,
+           Config& config)
+  : Subsystem(config.updatePeriod),
+    m_state(State::BOTTOM),
+    m_config(config),
+    m_motors(motors),
+    m_sensors(sensors),
+    m_lastState(m_state),
+    m_targetSlot(Screen::get()->slot("lift.target")),
+    m_angleSlot(Screen::get()->slot("lift.angle")),
+    m_errorSlot(Screen::get()->slot("lift.error")),
     m_pid(m_config.controllerSettings.kP, m_config.controllerSettings.kI,
           m_config.controllerSettings.kD,
           m_config.controllerSettings.windupRange, true),
     m_exitCondition(m_config.controllerSettings.smallError,
-                    m_config.controllerSettings.smallErrorTimeout) {}
+                    m_config.controllerSettings.smallErrorTimeout) {
+  const State states[] = {State::BOTTOM, State::MIDDLE, State::TOP};
+  const float dt = config.updatePeriod / 1000.0f;
+  for (State from : states) {
+    for (State to : states) {
+      m_profiles[from][to].generate(getTargetAngle(from), getTargetAngle(to),
+                                    config.profile, dt);
+    }
+  }
+  // an interrupted move can't be longer than one across the whole range
+  m_interruptedProfile.reserve(
+      std::abs(getTargetAngle(State::TOP) - getTargetAngle(State::BOTTOM)),
+      config.profile, dt);
+}
 
-float Lift::getTargetAngle() const {
-  switch (m_state) {
+void Lift::startMove() {
+  const State from = m_lastState;
+  const State to = m_state;
+  const uint32_t now = pros::millis();
+  // the precomputed moves start at rest, at the target of a state
+  const bool atRest = m_profile == nullptr ||
+                      now - m_profileStart >= m_profile->getDuration() * 1000;
+  const float angle = calcLiftAngle();
+  m_lastState = to;
+  m_pid.reset();
+  m_exitCondition.reset();
+  m_profileStart = now;
+  if (to == State::EMERGENCY_STOP) {
+    m_profile = nullptr;
+  } else if (to == State::CHARACTERIZE) {
+    m_profile = nullptr;
+    m_fit.reset();
+    m_sweepUp = true;
+    m_sweepStartVoltage = 0;
+    m_sweepVelocity = 0;
+  } else if (from <= State::TOP && atRest &&
+             std::abs(angle - getTargetAngle(from)) <
+                 m_config.controllerSettings.largeError) {
+    m_profile = &m_profiles[from][to];
+  } else {
+    // kept within the range reserved for, so the profile is never longer
+    // than one across it and never reallocates here. past the range, the
+    // pid pulls the lift onto the start of the profile
+    const float bottom = getTargetAngle(State::BOTTOM);
+    const float top = getTargetAngle(State::TOP);
+    const float start =
+        std::clamp(angle, std::min(bottom, top), std::max(bottom, top));
+    m_interruptedProfile.generate(start, getTargetAngle(to), m_config.profile,
+                                  m_config.updatePeriod / 1000.0f);
+    m_profile = &m_interruptedProfile;
+  }
+}
+
+float Lift::getTargetAngle() const { return getTargetAngle(m_state); }
+
+float Lift::getTargetAngle(State state) const {
+  switch (state) {
     case State::BOTTOM: return m_config.bottom;
     case State::MIDDLE: return m_config.middle;
     case State::TOP: return m_config.top;
@@ -48,21 +144,74 @@ float Lift::getTargetAngle() const {
 }
 
 float Lift::calcLiftAngle() const {
-  return m_rotation.get_angle() / 100.0 * m_config.gearRatio;
+  return m_sensors.get().liftAngle * m_config.gearRatio;
+}
+
+float Lift::calcLiftVelocity() const {
+  return m_sensors.get().liftVelocity * m_config.gearRatio;
+}
+
+void Lift::sweep() {
+  const float angle = calcLiftAngle();
+  const float velocity = calcLiftVelocity();
+  const float acceleration =
+      (velocity - m_sweepVelocity) * 1000 / m_config.updatePeriod;
+  m_sweepVelocity = velocity;
+  // the ramp is slow enough that the lift barely accelerates, except when it
+  // breaks free, so each sample kept is only gravity, friction and velocity
+  if (std::abs(acceleration) < m_config.sweepMaxAcceleration)
+    m_fit.add(angle, velocity, m_output);
+
+  const float time = (pros::millis() - m_profileStart) / 1000.0f;
+  const float ramp = m_config.sweepRate * time;
+  float output = m_sweepStartVoltage + (m_sweepUp ? ramp : -ramp);
+  if (m_sweepUp && angle >= m_config.top) {
+    // ramp back down from where the lift was pushed up from
+    m_sweepUp = false;
+    m_sweepStartVoltage = output;
+    m_profileStart = pros::millis();
+  }
+  const bool done = (!m_sweepUp && angle <= m_config.bottom) ||
+                    std::abs(output) >= 12000;
+  if (done) {
+    const ArmGains gains = m_fit.solve();
+    if (gains.samples == 0) {
+      logger::warn("lift: sweep didn't move the lift both ways, no fit");
+    } else {
+      logger::info("lift: kG {:.0f} horizontal {:.1f} kS {:.0f} kV {:.2f} "
+                   "from {} samples, rms {:.0f}mV",
+                   gains.kG, gains.horizontal, gains.kS, gains.kV,
+                   gains.samples, gains.rms);
+      char text[48];
+      *fmt::format_to_n(text, sizeof(text) - 1, "kG {:.0f} h {:.1f} kS {:.0f} "
+                        "kV {:.2f}", gains.kG, gains.horizontal, gains.kS,
+                        gains.kV)
+           .out = '\0';
+      Screen::get()->setText(3, text);
+    }
+    output = 0;
+    setState(State::BOTTOM);
+  }
+  m_motors.move_voltage(output);
+  m_output = output;
 }
 
 float Lift::calcError() const { return getTargetAngle() - calcLiftAngle(); }
 
+float Lift::getOutput() const { return m_output; }
+
 const Lift::State& Lift::getState() { return m_state; }
 
 // state setters
 void Lift::setState(State state) {
   m_state = state;
-  m_exitCondition.reset();
+  m_stateChanged.store(true, std::memory_order_release);
 }
 
 void Lift::emergencyStop() { setState(State::EMERGENCY_STOP); }
 
+void Lift::characterize() { setState(State::CHARACTERIZE); }
+
 void Lift::goToBottom() { setState(State::BOTTOM); }
 
 void Lift::goToMiddle() { setState(State::MIDDLE); }
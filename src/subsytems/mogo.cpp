@@ -2,7 +2,7 @@
 #include "subsystems.h"
 
 MogoClamp::MogoClamp(pros::adi::Pneumatics& pistons)
-  : Subsystem(), m_piston(pistons) {}
+  : Subsystem(EVENT_DRIVEN, Stage::ACTUATOR), m_piston(pistons) {}
 
 const MogoClamp::State& MogoClamp::getState() const { return m_state; }
 
@@ -11,11 +11,13 @@ void MogoClamp::update() {}
 void MogoClamp::close() {
   m_state = State::CLOSE;
   m_piston.set_value(true);
+  requestUpdate();
 }
 
 void MogoClamp::open() {
   m_state = State::OPEN;
   m_piston.set_value(false);
+  requestUpdate();
 }
 
 void MogoClamp::toggle() {
@@ -0,0 +1,105 @@
+#include "subsystems/ringDetector.h"
+#include "logger.h"
+#include <cmath>
+
+RingDetector::RingDetector(const SensorSampler& sensors, const Config& config)
+  : Subsystem(config.period, Stage::SENSOR), m_sensors(sensors),
+    m_config(config) {}
+
+void RingDetector::update() {
+  const SensorSnapshot snapshot = m_sensors.get();
+  if (snapshot.sequence == m_lastSequence) return;
+  m_lastSequence = snapshot.sequence;
+
+  const bool present = m_present.load(std::memory_order_relaxed);
+  if (present) {
+    // hue wraps around at red, so it's averaged as a direction
+    const float hue = snapshot.intakeHue * float(M_PI) / 180;
+    m_hueX += std::cos(hue);
+    m_hueY += std::sin(hue);
+    m_redSum += snapshot.intakeRgb.red;
+    m_greenSum += snapshot.intakeRgb.green;
+    m_blueSum += snapshot.intakeRgb.blue;
+    ++m_readings;
+  }
+
+  // rings touching on the chain never let the proximity drop, but a change
+  // of color while one is in view has to be the next ring
+  const RingColor color = classify(snapshot.intakeHue);
+  if (present && color != RingColor::NONE && color != m_color) {
+    if (m_recoloredAt == 0) m_recoloredAt = snapshot.timestamp;
+    if (snapshot.timestamp - m_recoloredAt >= m_config.debounce * 1000) {
+      left(m_recoloredAt);
+      entered(snapshot, m_recoloredAt);
+      m_recoloredAt = 0;
+    }
+  } else m_recoloredAt = 0;
+
+  const bool crossed =
+      present ? snapshot.intakeProximity < m_config.leaveProximity
+              : snapshot.intakeProximity > m_config.enterProximity;
+  if (!crossed) {
+    m_crossedAt = 0;
+    return;
+  }
+  if (m_crossedAt == 0) m_crossedAt = snapshot.timestamp;
+  if (snapshot.timestamp - m_crossedAt < m_config.debounce * 1000) return;
+
+  if (present) left(m_crossedAt);
+  else entered(snapshot, m_crossedAt);
+  m_present.store(!present, std::memory_order_relaxed);
+  m_crossedAt = 0;
+  m_recoloredAt = 0;
+}
+
+void RingDetector::entered(const SensorSnapshot& snapshot,
+                           uint64_t timestamp) {
+  RingEvent event;
+  event.type = RingEvent::Type::ENTERED;
+  event.timestamp = timestamp;
+  event.color = classify(snapshot.intakeHue);
+  event.hue = snapshot.intakeHue;
+  event.red = snapshot.intakeRgb.red;
+  event.green = snapshot.intakeRgb.green;
+  event.blue = snapshot.intakeRgb.blue;
+  m_color = event.color;
+  m_hueX = m_hueY = m_redSum = m_greenSum = m_blueSum = 0;
+  m_readings = 0;
+  push(event);
+}
+
+void RingDetector::left(uint64_t timestamp) {
+  RingEvent event;
+  event.type = RingEvent::Type::LEFT;
+  event.timestamp = timestamp;
+  const uint32_t readings = m_readings ? m_readings : 1;
+  event.hue = std::atan2(m_hueY, m_hueX) * 180 / float(M_PI);
+  if (event.hue < 0) event.hue += 360;
+  event.color = classify(event.hue);
+  event.red = m_redSum / readings;
+  event.green = m_greenSum / readings;
+  event.blue = m_blueSum / readings;
+  push(event);
+}
+
+void RingDetector::push(const RingEvent& event) {
+  if (!m_events.push(&event, sizeof(event)))
+    logger::warn("RingDetector: event queue full");
+}
+
+bool RingDetector::poll(RingEvent& event) {
+  return m_events.pop(&event, sizeof(event)) == int32_t(sizeof(event));
+}
+
+bool RingDetector::isRingPresent() const {
+  return m_present.load(std::memory_order_relaxed);
+}
+
+uint32_t RingDetector::getDropped() const { return m_events.getDropped(); }
+
+RingColor RingDetector::classify(float hue) const {
+  if (hue < m_config.redBelow || hue > m_config.redAbove) return RingColor::RED;
+  if (hue > m_config.blueAbove && hue < m_config.blueBelow)
+    return RingColor::BLUE;
+  return RingColor::NONE;
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#include "subsystems/snapshot.h"
+#include "logger.h"
+
+SensorSampler::SensorSampler(RobotConfig::Sensors& sensors,
+                             lemlib::OdomSensors& odomSensors,
+                             const Config& config)
+  : Subsystem(config.period, Stage::SENSOR), m_sensors(sensors),
+    m_odomSensors(odomSensors) {}
+
+void SensorSampler::update() {
+  lemlib::TrackingWheel* vertical = m_odomSensors.vertical1;
+  lemlib::TrackingWheel* horizontal = m_odomSensors.horizontal1;
+
+  SensorSnapshot snapshot;
+  snapshot.timestamp = pros::micros();
+  snapshot.sequence = ++m_sequence;
+  snapshot.vertical = vertical ? vertical->getDistanceTraveled() : 0;
+  snapshot.horizontal = horizontal ? horizontal->getDistanceTraveled() : 0;
+  snapshot.imuRotation = m_sensors.imu.get_rotation();
+  snapshot.liftAngle = m_sensors.lift.get_angle() / 100.0;
+  snapshot.liftVelocity = m_sensors.lift.get_velocity() / 100.0;
+  snapshot.intakeProximity = m_sensors.intake.get_proximity();
+  snapshot.intakeHue = m_sensors.intake.get_hue();
+  snapshot.intakeRgb = m_sensors.intake.get_rgb();
+  m_buffer.write(snapshot);
+
+  const uint32_t listeners = m_listenerCount.load(std::memory_order_acquire);
+  for (uint32_t i = 0; i < listeners; ++i)
+    pros::c::task_notify(m_listeners[i]);
+}
+
+SensorSnapshot SensorSampler::get() const { return m_buffer.read(); }
+
+void SensorSampler::addListener(pros::task_t task) {
+  const uint32_t count = m_listenerCount.load(std::memory_order_relaxed);
+  if (count == MAX_LISTENERS) {
+    logger::warn("SensorSampler: too many listeners");
+    return;
+  }
+  m_listeners[count] = task;
+  m_listenerCount.store(count + 1, std::memory_order_release);
+}
\ No newline at end of file
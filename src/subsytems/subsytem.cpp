@@ -1,5 +1,18 @@
 #include "subsystems.h"
 
-Subsystem::Subsystem() : m_id(SubsystemHandler::get()->addSubsystem(this)) {}
+Subsystem::Subsystem(uint32_t period, Stage stage)
+  : m_period(period), m_stage(stage),
+    m_id(SubsystemHandler::get()->addSubsystem(this)) {}
 
-Subsystem::~Subsystem() { SubsystemHandler::get()->removeSubsystem(m_id); }
\ No newline at end of file
+Subsystem::~Subsystem() { SubsystemHandler::get()->removeSubsystem(m_id); }
+
+void Subsystem::requestUpdate() {
+  m_updateRequested = true;
+  SubsystemHandler::get()->wake();
+}
+
+uint32_t Subsystem::getPeriod() const { return m_period; }
+
+Subsystem::Stage Subsystem::getStage() const { return m_stage; }
+
+const SubsystemStats& Subsystem::getStats() const { return m_stats; }
\ No newline at end of file
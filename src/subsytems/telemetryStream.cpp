@@ -0,0 +1,12 @@
+#include "subsystems/telemetryStream.h"
+
+TelemetryStream::TelemetryStream(Odometry& odom, const Lift& lift,
+                                 const Config& config)
+  : Subsystem(config.period, Stage::ACTUATOR), m_odom(odom), m_lift(lift) {}
+
+void TelemetryStream::update() {
+  const lemlib::Pose pose = m_odom.getPose();
+  m_pose.send(pose.x, pose.y, pose.theta);
+  m_liftChannel.send(m_lift.getTargetAngle(), m_lift.calcLiftAngle(),
+                     m_lift.getOutput(), m_lift.calcLiftVelocity());
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#include "telemetry.h"
+#include "logBuffer.h"
+
+namespace telemetry {
+static_assert(MAX_PAYLOAD + OVERHEAD <= LogBuffer::MAX_MESSAGE);
+
+void send(uint8_t* frame, uint8_t channel, uint8_t payloadSize) {
+  frame[0] = SYNC[0];
+  frame[1] = SYNC[1];
+  frame[2] = channel;
+  frame[3] = payloadSize;
+  const uint16_t checksum = fletcher16(frame + 2, payloadSize + 2);
+  std::memcpy(frame + 4 + payloadSize, &checksum, sizeof(checksum));
+  LogBuffer::get()->write(reinterpret_cast<const char*>(frame),
+                          payloadSize + OVERHEAD);
+}
+
+uint32_t now() { return pros::millis(); }
+} // namespace telemetry
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "trajectory.h"
+#include "lemlib/util.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+Trajectory::Trajectory(const asset& data) {
+  if (data.size < sizeof(TrajectoryHeader)) {
+    printf("trajectory: asset too small for a header, is it generated?\n");
+    return;
+  }
+  // the arrays are read in place, so the asset has to be aligned for floats
+  if (reinterpret_cast<uintptr_t>(data.buf) % alignof(float) != 0) {
+    printf("trajectory: asset is not aligned\n");
+    return;
+  }
+  const TrajectoryHeader& header =
+      *reinterpret_cast<const TrajectoryHeader*>(data.buf);
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+    printf("trajectory: asset is not a trajectory\n");
+    return;
+  }
+  if (header.version != VERSION) {
+    printf("trajectory: version %u, expected %u. regenerate the trajectory\n",
+           header.version, VERSION);
+    return;
+  }
+  if (header.count < 2 || header.period <= 0 ||
+      header.headerSize != sizeof(TrajectoryHeader) ||
+      data.size < assetSize(header.count)) {
+    printf("trajectory: asset is truncated\n");
+    return;
+  }
+
+  const float* arrays =
+      reinterpret_cast<const float*>(data.buf + header.headerSize);
+  m_count = header.count;
+  m_period = header.period;
+  m_x = arrays;
+  m_y = m_x + m_count;
+  m_theta = m_y + m_count;
+  m_velocity = m_theta + m_count;
+  m_angularVelocity = m_velocity + m_count;
+  m_acceleration = m_angularVelocity + m_count;
+}
+
+bool Trajectory::isValid() const { return m_count != 0; }
+
+uint32_t Trajectory::size() const { return m_count; }
+
+float Trajectory::period() const { return m_period; }
+
+float Trajectory::duration() const {
+  return m_count == 0 ? 0 : (m_count - 1) * m_period;
+}
+
+TrajectoryState Trajectory::sample(float time) const {
+  // samples are evenly spaced, so finding the ones around time is a division
+  const float position = std::clamp(time / m_period, 0.0f, m_count - 1.0f);
+  const uint32_t i = std::min(uint32_t(position), m_count - 2);
+  const float t = position - i;
+  const auto lerp = [t, i](const float* values) {
+    return values[i] + (values[i + 1] - values[i]) * t;
+  };
+  // theta wraps, so it's interpolated by the short way round
+  const float theta =
+      m_theta[i] + lemlib::angleError(m_theta[i + 1], m_theta[i], true) * t;
+  return {lerp(m_x),        lerp(m_y),
+          theta,            lerp(m_velocity),
+          lerp(m_angularVelocity),
+          lerp(m_acceleration)};
+}
\ No newline at end of file